@@ -0,0 +1,228 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../s21_matrix_oop.h"
+#include "../s21_numa.h"
+#include "../s21_parallel.h"
+#include "../s21_tiled_matrix.h"
+
+// Замеры производительности библиотеки. Без аргументов выполняются все
+// группы, иначе только группы, имена которых переданы в аргументах.
+
+namespace {
+double Seconds(const std::function<void()> &body, int repeats = 3) {
+  double best = 1e300;
+  for (int r = 0; r < repeats; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto stop = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(stop - start).count());
+  }
+  return best;
+}
+
+S21Matrix RandomSymmetric(int n) {
+  S21Matrix m(n, n);
+  unsigned state = 12345;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      state = state * 1664525u + 1013904223u;
+      m(i, j) = m(j, i) = static_cast<double>(state >> 8) / (1 << 24) - 0.5;
+    }
+  }
+  return m;
+}
+
+void BenchEigen() {
+  std::printf("%-10s %6s %14s %14s %10s\n", "eigen", "n", "values, s",
+              "vectors, s", "GFLOP/s");
+  for (int n : {500, 1000, 2000}) {
+    S21Matrix m = RandomSymmetric(n);
+    S21Matrix vectors;
+    double values_time = Seconds([&] { m.EigenSymmetric(); }, 1);
+    double vectors_time = Seconds([&] { m.EigenSymmetric(vectors); }, 1);
+    // 4/3 n^3 на тридиагонализацию
+    double gflops = 4.0 / 3.0 * n * n * n / values_time * 1e-9;
+    std::printf("%-10s %6d %14.3f %14.3f %10.2f\n", "", n, values_time,
+                vectors_time, gflops);
+  }
+}
+
+// Политики размещения: триада a = b + 3c со статическим разбиением строк
+// (ГБ/с) и умножение матриц. Разница видна только на машинах с несколькими
+// узлами NUMA.
+void BenchNuma() {
+  struct Policy {
+    const char *name;
+    S21NumaPolicy policy;
+  };
+  const Policy kPolicies[] = {
+      {"allocating", S21NumaPolicy::kAllocatingThread},
+      {"first", S21NumaPolicy::kFirstTouch},
+      {"interleave", S21NumaPolicy::kInterleave},
+  };
+  const int n = 4096;
+  const int gemm_n = 1024;
+  std::printf("numa: %d node(s), %d thread(s)\n", S21NumaNodeCount(),
+              S21GetThreadCount());
+  std::printf("%-10s %-12s %6s %12s %12s\n", "numa", "policy", "pin",
+              "triad, GB/s", "gemm, GF/s");
+  for (bool pinning : {false, true}) {
+    S21SetThreadPinning(pinning);
+    for (const Policy &policy : kPolicies) {
+      S21SetNumaPolicy(policy.policy);
+      S21Matrix a(n, n), b(n, n), c(n, n);
+      double *const *pa = a.getMatrix();
+      double *const *pb = b.getMatrix();
+      double *const *pc = c.getMatrix();
+      double triad = Seconds([&] {
+        S21ParallelForStatic(0, n, [&](int from, int to) {
+          for (int i = from; i < to; ++i) {
+            for (int j = 0; j < n; ++j) pa[i][j] = pb[i][j] + 3.0 * pc[i][j];
+          }
+        });
+      });
+      S21Matrix x = RandomSymmetric(gemm_n), y = RandomSymmetric(gemm_n);
+      double gemm = Seconds([&] { x * y; }, 1);
+      std::printf("%-10s %-12s %6s %12.2f %12.2f\n", "", policy.name,
+                  pinning ? "yes" : "no",
+                  3.0 * sizeof(double) * n * n / triad * 1e-9,
+                  2.0 * gemm_n * gemm_n * gemm_n / gemm * 1e-9);
+    }
+  }
+  S21SetNumaPolicy(S21NumaPolicy::kFirstTouch);
+  S21SetThreadPinning(false);
+}
+
+// Построчное хранение против плиточного на умножении и транспонировании
+void BenchTiled() {
+  std::printf("%-10s %6s %-12s %12s %14s\n", "tiled", "n", "layout",
+              "gemm, GF/s", "transpose, s");
+  for (int n : {1024, 2048, 4096}) {
+    S21Matrix a = RandomSymmetric(n), b = RandomSymmetric(n);
+    double gemm = Seconds([&] { a * b; }, 1);
+    double transpose = Seconds([&] { a.Transpose(); });
+    std::printf("%-10s %6d %-12s %12.2f %14.3f\n", "", n, "row-major",
+                2.0 * n * n * n / gemm * 1e-9, transpose);
+    for (S21TileOrder order :
+         {S21TileOrder::kBlockMajor, S21TileOrder::kMorton}) {
+      S21TiledMatrix ta(a, S21TiledMatrix::kDefaultTile, order);
+      S21TiledMatrix tb(b, S21TiledMatrix::kDefaultTile, order);
+      gemm = Seconds([&] { ta.Multiply(tb); }, 1);
+      transpose = Seconds([&] { ta.Transpose(); });
+      std::printf("%-10s %6d %-12s %12.2f %14.3f\n", "", n,
+                  order == S21TileOrder::kMorton ? "morton" : "block-major",
+                  2.0 * n * n * n / gemm * 1e-9, transpose);
+    }
+  }
+}
+
+// Поэлементный доступ через operator() и операции над маленькими
+// матрицами, где стоимость вызова сравнима с самой работой
+void BenchAccess() {
+  std::printf("%-10s %-16s %14s\n", "access", "loop", "ns/element");
+  const int n = 2048;
+  S21Matrix m(n, n);
+  const double elements = static_cast<double>(n) * n;
+  double write = Seconds([&] {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) m(i, j) = i - j;
+    }
+  });
+  const S21Matrix &view = m;
+  volatile double sink = 0.0;
+  double read = Seconds([&] {
+    double sum = 0.0;
+    for (int i = 0; i < view.getRows(); ++i) {
+      for (int j = 0; j < view.getCols(); ++j) sum += view(i, j);
+    }
+    sink = sum;
+  });
+  std::printf("%-10s %-16s %14.3f\n", "", "write", write / elements * 1e9);
+  std::printf("%-10s %-16s %14.3f\n", "", "read", read / elements * 1e9);
+
+  const int count = 200000;
+  S21Matrix a = RandomSymmetric(4), b = RandomSymmetric(4);
+  double multiply = Seconds([&] {
+    for (int k = 0; k < count; ++k) sink = (a * b)(0, 0);
+  });
+  double sum = Seconds([&] {
+    for (int k = 0; k < count; ++k) sink = (a + b)(3, 3);
+  });
+  std::printf("%-10s %-16s %14.1f\n", "", "4x4 multiply, ns",
+              multiply / count * 1e9);
+  std::printf("%-10s %-16s %14.1f\n", "", "4x4 sum, ns", sum / count * 1e9);
+}
+
+// A^T * A: транспонирование с полным умножением против Gram
+void BenchGram() {
+  std::printf("%-10s %8s %6s %16s %10s\n", "gram", "rows", "cols",
+              "transpose*a, s", "gram, s");
+  const int kShapes[][2] = {{200000, 32}, {50000, 256}, {2048, 2048}};
+  for (const auto &shape : kShapes) {
+    S21Matrix a(shape[0], shape[1]);
+    unsigned state = 777;
+    a.Apply([&state](double) {
+      state = state * 1664525u + 1013904223u;
+      return static_cast<double>(state >> 8) / (1 << 24) - 0.5;
+    }, false);
+    double full = Seconds([&] { a.Transpose() * a; }, 1);
+    double gram = Seconds([&] { a.Gram(); }, 1);
+    std::printf("%-10s %8d %6d %16.3f %10.3f\n", "", shape[0], shape[1],
+                full, gram);
+  }
+}
+
+// Блочное LU: определитель (2/3 n^3), обращение (2 n^3) и решение со 100
+// правыми частями в сравнении со скоростью умножения
+void BenchLU() {
+  std::printf("%-10s %6s %12s %12s %12s %12s\n", "lu", "n", "gemm, GF/s",
+              "det, GF/s", "inv, GF/s", "solve, s");
+  for (int n : {1000, 2000, 4000}) {
+    S21Matrix a = RandomSymmetric(n);
+    for (int i = 0; i < n; ++i) a(i, i) += 10.0;
+    S21Matrix b(n, 100);
+    double gemm = Seconds([&] { a * a; }, 1);
+    double det = Seconds([&] {
+      S21Matrix copy(a);
+      copy(0, 0) += 1e-9;  // мимо кеша результатов
+      copy.Determinant();
+    }, 1);
+    double inverse = Seconds([&] { a.InverseMatrix(1e-300); }, 1);
+    double solve = Seconds([&] { a.Solve(b); }, 1);
+    const double cube = static_cast<double>(n) * n * n;
+    std::printf("%-10s %6d %12.2f %12.2f %12.2f %12.3f\n", "", n,
+                2.0 * cube / gemm * 1e-9, 2.0 / 3.0 * cube / det * 1e-9,
+                2.0 * cube / inverse * 1e-9, solve);
+  }
+}
+
+struct Group {
+  const char *name;
+  void (*run)();
+};
+
+const Group kGroups[] = {
+    {"access", BenchAccess},
+    {"eigen", BenchEigen},
+    {"gram", BenchGram},
+    {"lu", BenchLU},
+    {"numa", BenchNuma},
+    {"tiled", BenchTiled},
+};
+}  // namespace
+
+int main(int argc, char **argv) {
+  for (const Group &group : kGroups) {
+    bool selected = argc < 2;
+    for (int k = 1; k < argc; ++k) {
+      if (std::strcmp(argv[k], group.name) == 0) selected = true;
+    }
+    if (selected) group.run();
+  }
+  return 0;
+}
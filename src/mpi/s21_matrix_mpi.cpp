@@ -0,0 +1,431 @@
+#include "s21_matrix_mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "../s21_matrix_kernels.h"
+
+namespace {
+// число индексов [0, global), попадающих процессу index из count при
+// циклической раздаче блоков размера block
+int CyclicCount(int global, int block, int index, int count) {
+  int blocks = global / block;
+  int rest = global % block;
+  int result = blocks / count * block;
+  if (blocks % count > index) result += block;
+  if (blocks % count == index) result += rest;
+  return result;
+}
+
+// пара для MPI_MAXLOC: модуль элемента и глобальный номер строки
+struct PivotCandidate {
+  double value;
+  int index;
+};
+
+std::vector<double *> Rows(double *data, int rows, int stride) {
+  std::vector<double *> result(rows);
+  for (int i = 0; i < rows; ++i) {
+    result[i] = data + static_cast<size_t>(i) * stride;
+  }
+  return result;
+}
+}  // namespace
+
+struct S21DistributedMatrix::Factor {
+  S21DistributedMatrix lu;
+  std::vector<int> pivots;
+  bool singular;
+};
+
+S21ProcessGrid::S21ProcessGrid(MPI_Comm comm) {
+  MPI_Comm_dup(comm, &comm_);
+  int size = 0;
+  MPI_Comm_size(comm_, &size);
+  MPI_Comm_rank(comm_, &rank_);
+  rows_ = static_cast<int>(std::sqrt(static_cast<double>(size)));
+  while (size % rows_ != 0) --rows_;
+  cols_ = size / rows_;
+  row_ = rank_ / cols_;
+  col_ = rank_ % cols_;
+  MPI_Comm_split(comm_, row_, col_, &row_comm_);
+  MPI_Comm_split(comm_, col_, row_, &col_comm_);
+}
+
+S21ProcessGrid::~S21ProcessGrid() {
+  MPI_Comm_free(&row_comm_);
+  MPI_Comm_free(&col_comm_);
+  MPI_Comm_free(&comm_);
+}
+
+S21DistributedMatrix::S21DistributedMatrix(const S21ProcessGrid &grid,
+                                           int rows, int cols, int block)
+    : grid_(&grid), rows_(rows), cols_(cols), block_(block) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument("Rows and columns must be positive integers");
+  }
+  if (block <= 0) {
+    throw std::invalid_argument("Block size must be a positive integer.");
+  }
+  local_rows_ = LocalRowsBefore(rows);
+  local_cols_ = LocalColsBefore(cols);
+  local_.assign(static_cast<size_t>(local_rows_) * local_cols_, 0.0);
+}
+
+S21DistributedMatrix::S21DistributedMatrix(const S21ProcessGrid &grid,
+                                           const S21Matrix &global, int block)
+    : S21DistributedMatrix(grid, global.getRows(), global.getCols(), block) {
+  double **src = global.getMatrix();
+  for (int i = 0; i < local_rows_; ++i) {
+    const double *row = src[GlobalRow(i)];
+    for (int j = 0; j < local_cols_; ++j) Local(i, j) = row[GlobalCol(j)];
+  }
+}
+
+int S21DistributedMatrix::GlobalRow(int local) const {
+  return (local / block_ * grid_->getRows() + grid_->getRow()) * block_ +
+         local % block_;
+}
+
+int S21DistributedMatrix::GlobalCol(int local) const {
+  return (local / block_ * grid_->getCols() + grid_->getCol()) * block_ +
+         local % block_;
+}
+
+int S21DistributedMatrix::LocalRowsBefore(int global) const {
+  return CyclicCount(global, block_, grid_->getRow(), grid_->getRows());
+}
+
+int S21DistributedMatrix::LocalColsBefore(int global) const {
+  return CyclicCount(global, block_, grid_->getCol(), grid_->getCols());
+}
+
+bool S21DistributedMatrix::OwnsRow(int global) const {
+  return global / block_ % grid_->getRows() == grid_->getRow();
+}
+
+bool S21DistributedMatrix::OwnsCol(int global) const {
+  return global / block_ % grid_->getCols() == grid_->getCol();
+}
+
+double &S21DistributedMatrix::Local(int i, int j) {
+  return local_[static_cast<size_t>(i) * local_cols_ + j];
+}
+
+double S21DistributedMatrix::Local(int i, int j) const {
+  return local_[static_cast<size_t>(i) * local_cols_ + j];
+}
+
+std::vector<double *> S21DistributedMatrix::RowPointers(int row_begin,
+                                                        int col_begin) {
+  std::vector<double *> result = Rows(local_.data(), local_rows_, local_cols_);
+  result.erase(result.begin(), result.begin() + row_begin);
+  for (double *&row : result) row += col_begin;
+  return result;
+}
+
+// каждый процесс вписывает свои блоки в нулевую матрицу, сумма по всем
+// процессам даёт матрицу целиком
+S21Matrix S21DistributedMatrix::Gather() const {
+  S21Matrix result(rows_, cols_);
+  double **dst = result.getMatrix();
+  for (int i = 0; i < local_rows_; ++i) {
+    double *row = dst[GlobalRow(i)];
+    for (int j = 0; j < local_cols_; ++j) row[GlobalCol(j)] = Local(i, j);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, dst[0], rows_ * cols_, MPI_DOUBLE, MPI_SUM,
+                grid_->getComm());
+  return result;
+}
+
+S21DistributedMatrix S21DistributedMatrix::Multiply(
+    const S21DistributedMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrices cannot be multiplied: incompatible dimensions.");
+  }
+  if (grid_ != other.grid_ || block_ != other.block_) {
+    throw std::invalid_argument(
+        "Matrices must share the process grid and block size.");
+  }
+  S21DistributedMatrix result(*grid_, rows_, other.cols_, block_);
+  const int m = local_rows_;
+  const int n = other.local_cols_;
+  const int panels = (cols_ + block_ - 1) / block_;
+  std::vector<double> a_panel[2], b_panel[2];
+  MPI_Request requests[2][2];
+  for (int slot = 0; slot < 2; ++slot) {
+    a_panel[slot].resize(static_cast<size_t>(m) * block_);
+    b_panel[slot].resize(static_cast<size_t>(block_) * n);
+  }
+  // панель kb столбцов A идёт от процесса kb % cols по строке решётки,
+  // панель kb строк B - от процесса kb % rows по столбцу решётки
+  auto post = [&](int kb, int slot) {
+    const int width = std::min(block_, cols_ - kb * block_);
+    const int a_owner = kb % grid_->getCols();
+    const int b_owner = kb % grid_->getRows();
+    if (grid_->getCol() == a_owner) {
+      const int col = kb / grid_->getCols() * block_;
+      for (int i = 0; i < m; ++i) {
+        std::memcpy(&a_panel[slot][static_cast<size_t>(i) * width],
+                    &local_[static_cast<size_t>(i) * local_cols_ + col],
+                    sizeof(double) * width);
+      }
+    }
+    if (grid_->getRow() == b_owner) {
+      const int row = kb / grid_->getRows() * block_;
+      std::memcpy(b_panel[slot].data(),
+                  other.local_.data() + static_cast<size_t>(row) * n,
+                  sizeof(double) * width * n);
+    }
+    MPI_Ibcast(a_panel[slot].data(), m * width, MPI_DOUBLE, a_owner,
+               grid_->getRowComm(), &requests[slot][0]);
+    MPI_Ibcast(b_panel[slot].data(), width * n, MPI_DOUBLE, b_owner,
+               grid_->getColComm(), &requests[slot][1]);
+  };
+  std::vector<double *> c_rows = result.RowPointers(0, 0);
+  post(0, 0);
+  for (int kb = 0; kb < panels; ++kb) {
+    const int slot = kb % 2;
+    const int width = std::min(block_, cols_ - kb * block_);
+    MPI_Waitall(2, requests[slot], MPI_STATUSES_IGNORE);
+    // следующая панель пересылается, пока считается текущая
+    if (kb + 1 < panels) post(kb + 1, 1 - slot);
+    if (m > 0 && n > 0) {
+      std::vector<double *> a_rows = Rows(a_panel[slot].data(), m, width);
+      std::vector<double *> b_rows = Rows(b_panel[slot].data(), width, n);
+      S21GemmKernel(m, n, width, 1.0, a_rows.data(), false, b_rows.data(),
+                    false, 1.0, c_rows.data());
+    }
+  }
+  return result;
+}
+
+// перестановка глобальных строк целиком; строки на разных процессах
+// столбца решётки меняются через MPI_Sendrecv_replace
+void S21DistributedMatrix::SwapRows(int first, int second) {
+  const int first_owner = first / block_ % grid_->getRows();
+  const int second_owner = second / block_ % grid_->getRows();
+  const int me = grid_->getRow();
+  if (me != first_owner && me != second_owner) return;
+  if (local_cols_ == 0) return;
+  if (first_owner == second_owner) {
+    double *a = &Local(LocalRowsBefore(first), 0);
+    double *b = &Local(LocalRowsBefore(second), 0);
+    std::swap_ranges(a, a + local_cols_, b);
+    return;
+  }
+  int row = me == first_owner ? first : second;
+  int partner = me == first_owner ? second_owner : first_owner;
+  MPI_Sendrecv_replace(&Local(LocalRowsBefore(row), 0), local_cols_,
+                       MPI_DOUBLE, partner, 0, partner, 0,
+                       grid_->getColComm(), MPI_STATUS_IGNORE);
+}
+
+// Правостороннее блочное LU (как ScaLAPACK pdgetrf): панель раскладывается
+// процессами своего столбца решётки, затем L панели рассылается по строкам,
+// строка блоков U - по столбцам, и хвост обновляется локальным GEMM
+S21DistributedMatrix::Factor S21DistributedMatrix::Decompose() const {
+  Factor factor{*this, std::vector<int>(rows_), false};
+  S21DistributedMatrix &a = factor.lu;
+  const int n = rows_;
+  const int my_row = grid_->getRow();
+  const int my_col = grid_->getCol();
+  std::vector<double> l_panel, u_block, pivot_row;
+  for (int k0 = 0; k0 < n; k0 += block_) {
+    const int k1 = std::min(n, k0 + block_);
+    const int width = k1 - k0;
+    const int panel_col = k0 / block_ % grid_->getCols();
+    const int panel_row = k0 / block_ % grid_->getRows();
+    const int col0 = a.LocalColsBefore(k0);
+    for (int j = k0; j < k1; ++j) {
+      const int col = col0 + (j - k0);
+      PivotCandidate best{-1.0, j};
+      if (my_col == panel_col) {
+        PivotCandidate local{-1.0, j};
+        for (int i = a.LocalRowsBefore(j); i < a.local_rows_; ++i) {
+          double value = std::fabs(a.Local(i, col));
+          if (value > local.value) local = {value, a.GlobalRow(i)};
+        }
+        MPI_Allreduce(&local, &best, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                      grid_->getColComm());
+      }
+      MPI_Bcast(&best, 1, MPI_DOUBLE_INT, panel_col, grid_->getRowComm());
+      if (best.value == 0.0) {
+        factor.singular = true;
+        return factor;
+      }
+      factor.pivots[j] = best.index;
+      if (best.index != j) a.SwapRows(j, best.index);
+      if (my_col != panel_col) continue;
+      // строка j панели нужна всем процессам столбца для исключения
+      pivot_row.assign(k1 - j, 0.0);
+      const int owner = j / block_ % grid_->getRows();
+      if (my_row == owner) {
+        const double *row = &a.Local(a.LocalRowsBefore(j), col);
+        std::copy(row, row + (k1 - j), pivot_row.begin());
+      }
+      MPI_Bcast(pivot_row.data(), k1 - j, MPI_DOUBLE, owner,
+                grid_->getColComm());
+      for (int i = a.LocalRowsBefore(j + 1); i < a.local_rows_; ++i) {
+        double *row = &a.Local(i, col);
+        const double l = row[0] / pivot_row[0];
+        row[0] = l;
+        for (int c = 1; c < k1 - j; ++c) row[c] -= l * pivot_row[c];
+      }
+    }
+
+    const int m = a.local_rows_;
+    l_panel.resize(static_cast<size_t>(m) * width);
+    if (my_col == panel_col) {
+      for (int i = 0; i < m; ++i) {
+        std::memcpy(&l_panel[static_cast<size_t>(i) * width],
+                    &a.Local(i, col0), sizeof(double) * width);
+      }
+    }
+    MPI_Bcast(l_panel.data(), m * width, MPI_DOUBLE, panel_col,
+              grid_->getRowComm());
+
+    const int trail_col = a.LocalColsBefore(k1);
+    const int trail_cols = a.local_cols_ - trail_col;
+    u_block.resize(static_cast<size_t>(width) * trail_cols);
+    if (my_row == panel_row && trail_cols > 0) {
+      // U12 = L11^-1 * A12, L11 с единичной диагональю
+      const int row0 = a.LocalRowsBefore(k0);
+      for (int r = 0; r < width; ++r) {
+        double *dst = &a.Local(row0 + r, trail_col);
+        for (int p = 0; p < r; ++p) {
+          const double l = l_panel[static_cast<size_t>(row0 + r) * width + p];
+          const double *src = &a.Local(row0 + p, trail_col);
+          for (int c = 0; c < trail_cols; ++c) dst[c] -= l * src[c];
+        }
+        std::memcpy(&u_block[static_cast<size_t>(r) * trail_cols], dst,
+                    sizeof(double) * trail_cols);
+      }
+    }
+    MPI_Bcast(u_block.data(), width * trail_cols, MPI_DOUBLE, panel_row,
+              grid_->getColComm());
+
+    const int trail_row = a.LocalRowsBefore(k1);
+    const int trail_rows = m - trail_row;
+    if (trail_rows > 0 && trail_cols > 0) {
+      std::vector<double *> l_rows = Rows(
+          &l_panel[static_cast<size_t>(trail_row) * width], trail_rows, width);
+      std::vector<double *> u_rows =
+          Rows(u_block.data(), width, trail_cols);
+      std::vector<double *> c_rows = a.RowPointers(trail_row, trail_col);
+      S21GemmKernel(trail_rows, trail_cols, width, -1.0, l_rows.data(), false,
+                    u_rows.data(), false, 1.0, c_rows.data());
+    }
+  }
+  return factor;
+}
+
+double S21DistributedMatrix::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Matrix must be square to calculate determinant.");
+  }
+  Factor factor = Decompose();
+  if (factor.singular) return 0.0;
+  double product = 1.0;
+  for (int j = 0; j < rows_; ++j) {
+    if (OwnsRow(j) && OwnsCol(j)) {
+      product *= factor.lu.Local(LocalRowsBefore(j), LocalColsBefore(j));
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &product, 1, MPI_DOUBLE, MPI_PROD,
+                grid_->getComm());
+  for (int j = 0; j < rows_; ++j) {
+    if (factor.pivots[j] != j) product = -product;
+  }
+  return product;
+}
+
+// Подстановки по блокам: вклад уже найденных блоков X копится локально,
+// перед решением диагонального блока вклады суммируются по всем процессам,
+// а решённый блок рассылается всем
+S21Matrix S21DistributedMatrix::Solve(const S21Matrix &b) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to solve a system.");
+  }
+  if (b.getRows() != rows_) {
+    throw std::invalid_argument(
+        "Right-hand side must have as many rows as the matrix.");
+  }
+  Factor factor = Decompose();
+  if (factor.singular) {
+    throw std::invalid_argument("Matrix is singular, system cannot be solved.");
+  }
+  const S21DistributedMatrix &lu = factor.lu;
+  const int n = rows_;
+  const int m = b.getCols();
+  S21Matrix x(b);
+  x.Detach();
+  double **xs = x.getMatrix();
+  for (int j = 0; j < n; ++j) {
+    if (factor.pivots[j] != j) {
+      std::swap_ranges(xs[j], xs[j] + m, xs[factor.pivots[j]]);
+    }
+  }
+  const int blocks = (n + block_ - 1) / block_;
+  std::vector<double> sums, solved;
+  for (int pass = 0; pass < 2; ++pass) {
+    const bool lower = pass == 0;
+    std::vector<double> contributions(static_cast<size_t>(n) * m, 0.0);
+    for (int step = 0; step < blocks; ++step) {
+      const int kb = lower ? step : blocks - 1 - step;
+      const int r0 = kb * block_;
+      const int height = std::min(block_, n - r0);
+      const int owner_row = kb % grid_->getRows();
+      const int owner_col = kb % grid_->getCols();
+      sums.assign(contributions.data() + static_cast<size_t>(r0) * m,
+                  contributions.data() + static_cast<size_t>(r0 + height) * m);
+      MPI_Allreduce(MPI_IN_PLACE, sums.data(), height * m, MPI_DOUBLE,
+                    MPI_SUM, grid_->getComm());
+      solved.resize(static_cast<size_t>(height) * m);
+      if (grid_->getRow() == owner_row && grid_->getCol() == owner_col) {
+        const int row0 = LocalRowsBefore(r0);
+        const int col0 = LocalColsBefore(r0);
+        for (int s = 0; s < height; ++s) {
+          const int r = lower ? s : height - 1 - s;
+          double *y = &solved[static_cast<size_t>(r) * m];
+          for (int c = 0; c < m; ++c) y[c] = xs[r0 + r][c] - sums[r * m + c];
+          const int from = lower ? 0 : r + 1;
+          const int to = lower ? r : height;
+          for (int p = from; p < to; ++p) {
+            const double coef = lu.Local(row0 + r, col0 + p);
+            const double *known = &solved[static_cast<size_t>(p) * m];
+            for (int c = 0; c < m; ++c) y[c] -= coef * known[c];
+          }
+          if (!lower) {
+            const double diag = lu.Local(row0 + r, col0 + r);
+            for (int c = 0; c < m; ++c) y[c] /= diag;
+          }
+        }
+      }
+      MPI_Bcast(solved.data(), height * m, MPI_DOUBLE,
+                grid_->RankOf(owner_row, owner_col), grid_->getComm());
+      for (int r = 0; r < height; ++r) {
+        std::copy(&solved[static_cast<size_t>(r) * m],
+                  &solved[static_cast<size_t>(r + 1) * m], xs[r0 + r]);
+      }
+      if (grid_->getCol() != owner_col) continue;
+      // L ниже диагонального блока или U выше него
+      const int col0 = LocalColsBefore(r0);
+      const int row_from = lower ? LocalRowsBefore(r0 + height) : 0;
+      const int row_to = lower ? local_rows_ : LocalRowsBefore(r0);
+      for (int i = row_from; i < row_to; ++i) {
+        double *acc = &contributions[static_cast<size_t>(GlobalRow(i)) * m];
+        for (int p = 0; p < height; ++p) {
+          const double coef = lu.Local(i, col0 + p);
+          const double *known = &solved[static_cast<size_t>(p) * m];
+          for (int c = 0; c < m; ++c) acc[c] += coef * known[c];
+        }
+      }
+    }
+  }
+  return x;
+}
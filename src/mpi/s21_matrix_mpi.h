@@ -0,0 +1,94 @@
+#ifndef S21_MATRIX_MPI_H
+#define S21_MATRIX_MPI_H
+
+#include <mpi.h>
+
+#include <vector>
+
+#include "../s21_matrix_oop.h"
+
+// Необязательный распределённый бэкенд на MPI (make mpi_test). Не входит
+// в s21_matrix_oop.a: собирается отдельно через mpicxx.
+
+// Двумерная решётка процессов rows x cols, как можно ближе к квадратной.
+// Процесс с номером r в comm стоит в строке r / cols и столбце r % cols.
+class S21ProcessGrid {
+ public:
+  explicit S21ProcessGrid(MPI_Comm comm = MPI_COMM_WORLD);
+  S21ProcessGrid(const S21ProcessGrid &) = delete;
+  S21ProcessGrid &operator=(const S21ProcessGrid &) = delete;
+  ~S21ProcessGrid();
+
+  MPI_Comm getComm() const { return comm_; }
+  // процессы одной строки решётки, номер в нём - столбец процесса
+  MPI_Comm getRowComm() const { return row_comm_; }
+  // процессы одного столбца решётки, номер в нём - строка процесса
+  MPI_Comm getColComm() const { return col_comm_; }
+  int getRank() const { return rank_; }
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  int getRow() const { return row_; }
+  int getCol() const { return col_; }
+  int RankOf(int row, int col) const { return row * cols_ + col; }
+
+ private:
+  MPI_Comm comm_, row_comm_, col_comm_;
+  int rank_, rows_, cols_, row_, col_;
+};
+
+// Матрица, распределённая блочно-циклически (как в ScaLAPACK): блок
+// (bi, bj) размера block x block хранится у процесса
+// (bi % grid.rows, bj % grid.cols). Локальные блоки лежат подряд
+// по строкам в порядке возрастания глобальных индексов.
+class S21DistributedMatrix {
+ public:
+  static constexpr int kDefaultBlock = 64;
+
+  S21DistributedMatrix(const S21ProcessGrid &grid, int rows, int cols,
+                       int block = kDefaultBlock);
+  // каждый процесс берёт свои блоки из одинаковой у всех матрицы global
+  S21DistributedMatrix(const S21ProcessGrid &grid, const S21Matrix &global,
+                       int block = kDefaultBlock);
+
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  int getBlock() const { return block_; }
+  int getLocalRows() const { return local_rows_; }
+  int getLocalCols() const { return local_cols_; }
+  // глобальный индекс строки/столбца по локальному
+  int GlobalRow(int local) const;
+  int GlobalCol(int local) const;
+  double &Local(int i, int j);
+  double Local(int i, int j) const;
+
+  // собирает матрицу целиком на всех процессах (коллективная операция)
+  S21Matrix Gather() const;
+
+  // SUMMA: панели A и B рассылаются по строкам и столбцам решётки,
+  // пересылка следующей панели идёт одновременно с умножением текущей
+  S21DistributedMatrix Multiply(const S21DistributedMatrix &other) const;
+  // через распределённое блочное LU с выбором ведущего элемента
+  double Determinant() const;
+  // решение A * X = B, B и X одинаковы на всех процессах
+  S21Matrix Solve(const S21Matrix &b) const;
+
+ private:
+  // результат LU: множители L и U на месте A, перестановки строк
+  struct Factor;
+
+  Factor Decompose() const;
+  void SwapRows(int first, int second);
+  std::vector<double *> RowPointers(int row_begin, int col_begin);
+  // число локальных строк/столбцов с глобальным индексом меньше global
+  int LocalRowsBefore(int global) const;
+  int LocalColsBefore(int global) const;
+  bool OwnsRow(int global) const;
+  bool OwnsCol(int global) const;
+
+  const S21ProcessGrid *grid_;
+  int rows_, cols_, block_;
+  int local_rows_, local_cols_;
+  std::vector<double> local_;
+};
+
+#endif  // S21_MATRIX_MPI_H
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <cmath>
+
+#include "s21_matrix_mpi.h"
+
+// Запуск: make mpi_test (mpirun -np 4). Все процессы выполняют одни и те же
+// тесты, вывод печатает только процесс 0.
+
+namespace {
+// одинаковые на всех процессах псевдослучайные значения из [-1, 1)
+void FillMatrix(S21Matrix &m, unsigned seed) {
+  for (int i = 0; i < m.getRows(); ++i) {
+    for (int j = 0; j < m.getCols(); ++j) {
+      seed = seed * 1664525u + 1013904223u;
+      m(i, j) = static_cast<double>(seed >> 8) / (1 << 23) - 1.0;
+    }
+  }
+}
+}  // namespace
+
+TEST(S21MatrixMpiTest, GridCoversAllProcesses) {
+  S21ProcessGrid grid;
+  int size = 0;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  EXPECT_EQ(grid.getRows() * grid.getCols(), size);
+  EXPECT_LE(grid.getRows(), grid.getCols());
+  EXPECT_EQ(grid.RankOf(grid.getRow(), grid.getCol()), grid.getRank());
+}
+
+TEST(S21MatrixMpiTest, DistributeAndGather) {
+  S21ProcessGrid grid;
+  S21Matrix a(37, 23);
+  FillMatrix(a, 1);
+  S21DistributedMatrix distributed(grid, a, 5);
+  EXPECT_TRUE(distributed.Gather() == a);
+  int rows = distributed.getLocalRows();
+  MPI_Allreduce(MPI_IN_PLACE, &rows, 1, MPI_INT, MPI_SUM, grid.getColComm());
+  EXPECT_EQ(rows, 37);
+}
+
+TEST(S21MatrixMpiTest, SummaMatchesMultiply) {
+  S21ProcessGrid grid;
+  S21Matrix a(150, 97), b(97, 120);
+  FillMatrix(a, 2);
+  FillMatrix(b, 3);
+  S21Matrix expected = a * b;
+  for (int block : {16, 64}) {
+    S21DistributedMatrix da(grid, a, block), db(grid, b, block);
+    EXPECT_TRUE(da.Multiply(db).Gather() == expected);
+  }
+  S21DistributedMatrix da(grid, a, 16);
+  EXPECT_THROW(da.Multiply(da), std::invalid_argument);
+}
+
+TEST(S21MatrixMpiTest, DeterminantMatchesSerial) {
+  S21ProcessGrid grid;
+  S21Matrix small(8, 8);
+  FillMatrix(small, 4);
+  EXPECT_NEAR(S21DistributedMatrix(grid, small, 3).Determinant(),
+              small.Determinant(), 1e-9 * std::fabs(small.Determinant()));
+
+  // A = L * U с известным определителем prod(U_ii)
+  const int n = 90;
+  S21Matrix l(n, n), u(n, n);
+  double expected = 1.0;
+  for (int i = 0; i < n; ++i) {
+    l(i, i) = 1.0;
+    u(i, i) = 1.0 + 0.01 * i;
+    expected *= u(i, i);
+    for (int j = 0; j < i; ++j) l(i, j) = std::sin(i * 0.3 + j) * 0.5;
+    for (int j = i + 1; j < n; ++j) u(i, j) = std::cos(i + j * 0.2);
+  }
+  S21DistributedMatrix a(grid, l * u, 8);
+  EXPECT_NEAR(a.Determinant(), expected, 1e-8 * expected);
+
+  S21Matrix singular(20, 20);
+  EXPECT_EQ(S21DistributedMatrix(grid, singular, 4).Determinant(), 0.0);
+}
+
+TEST(S21MatrixMpiTest, SolveMatchesSerial) {
+  S21ProcessGrid grid;
+  const int n = 120;
+  S21Matrix a(n, n), b(n, 3);
+  FillMatrix(a, 5);
+  FillMatrix(b, 6);
+  S21Matrix expected = a.Solve(b);
+  for (int block : {7, 16}) {
+    S21Matrix x = S21DistributedMatrix(grid, a, block).Solve(b);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        EXPECT_NEAR(x(i, j), expected(i, j),
+                    1e-8 * (1.0 + std::fabs(expected(i, j))));
+      }
+    }
+  }
+  S21Matrix singular(10, 10);
+  EXPECT_THROW(S21DistributedMatrix(grid, singular, 4).Solve(S21Matrix(10, 1)),
+               std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+  MPI_Init(&argc, &argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank != 0) {
+    ::testing::TestEventListeners &listeners =
+        ::testing::UnitTest::GetInstance()->listeners();
+    delete listeners.Release(listeners.default_result_printer());
+  }
+  int result = RUN_ALL_TESTS();
+  MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Finalize();
+  return result;
+}
@@ -0,0 +1,917 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <climits>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../s21_matrix_oop.h"
+
+// Модуль s21_matrix для Python (make python). S21Matrix поддерживает
+// протокол буфера и __array_interface__: numpy.asarray(m) смотрит в память
+// матрицы, а S21Matrix(array) над записываемым C-непрерывным массиву
+// float64 работает прямо в памяти массива. Долгие операции выполняются
+// без GIL.
+
+namespace {
+struct S21PyMatrix {
+  PyObject_HEAD
+  S21Matrix *matrix;
+  // буфер чужого объекта, в памяти которого лежит матрица (View)
+  Py_buffer source;
+  // выданные буферы и вычисления без GIL: пока их больше нуля, хранилище
+  // нельзя заменять
+  Py_ssize_t pins;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+};
+
+PyTypeObject *g_matrix_type = nullptr;
+
+S21PyMatrix *AsMatrix(PyObject *object) {
+  return reinterpret_cast<S21PyMatrix *>(object);
+}
+
+bool IsMatrix(PyObject *object) {
+  return PyObject_TypeCheck(object, g_matrix_type);
+}
+
+// исключение C++ -> исключение Python, вызывается внутри catch
+PyObject *SetError() {
+  try {
+    throw;
+  } catch (const std::invalid_argument &e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+  } catch (const std::out_of_range &e) {
+    PyErr_SetString(PyExc_IndexError, e.what());
+  } catch (const std::bad_alloc &) {
+    PyErr_NoMemory();
+  } catch (const std::exception &e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+  }
+  return nullptr;
+}
+
+// int Python -> int; значения вне диапазона int не усекаются
+bool ToInt(PyObject *object, int &value) {
+  long number = PyLong_AsLong(object);
+  if (number == -1 && PyErr_Occurred()) return false;
+  if (number < INT_MIN || number > INT_MAX) {
+    PyErr_SetString(PyExc_OverflowError,
+                    "Python int too large to convert to C int");
+    return false;
+  }
+  value = static_cast<int>(number);
+  return true;
+}
+
+// body выполняется без GIL; хранилища матриц pinned тем временем не
+// могут быть заменены из других потоков Python
+template <typename Body>
+bool RunUnlocked(std::initializer_list<S21PyMatrix *> pinned, Body body) {
+  for (S21PyMatrix *m : pinned) ++m->pins;
+  std::exception_ptr error;
+  Py_BEGIN_ALLOW_THREADS
+  try {
+    body();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  Py_END_ALLOW_THREADS
+  for (S21PyMatrix *m : pinned) --m->pins;
+  if (error) {
+    try {
+      std::rethrow_exception(error);
+    } catch (...) {
+      SetError();
+    }
+    return false;
+  }
+  return true;
+}
+
+PyObject *NewMatrix(S21Matrix &&value) {
+  PyObject *object = g_matrix_type->tp_alloc(g_matrix_type, 0);
+  if (object == nullptr) return nullptr;
+  try {
+    AsMatrix(object)->matrix = new S21Matrix(std::move(value));
+  } catch (...) {
+    Py_DECREF(object);
+    return SetError();
+  }
+  return object;
+}
+
+void ReleaseSource(S21PyMatrix *self) {
+  if (self->source.obj != nullptr) PyBuffer_Release(&self->source);
+}
+
+// Результат операции на месте. При том же размере он копируется в
+// существующее хранилище, поэтому массивы NumPy над матрицей (и память,
+// над которой построена сама матрица) видят новые значения. Иначе
+// хранилище заменяется, что запрещено при выданных буферах.
+bool Replace(S21PyMatrix *self, S21Matrix &&value) {
+  S21Matrix &m = *self->matrix;
+  if (value.getRows() == m.getRows() && value.getCols() == m.getCols()) {
+    double *const *src = value.getMatrix();
+    double *const *dst = m.getMatrix();
+    for (int i = 0; i < m.getRows(); ++i) {
+      std::copy(src[i], src[i] + m.getCols(), dst[i]);
+    }
+    return true;
+  }
+  if (self->pins > 0) {
+    PyErr_SetString(PyExc_BufferError,
+                    "Cannot resize a matrix while its memory is exported.");
+    return false;
+  }
+  m = std::move(value);
+  ReleaseSource(self);
+  return true;
+}
+
+// формат элементов буфера - double в порядке байт машины
+bool IsDoubleFormat(const Py_buffer &view) {
+  if (view.itemsize != sizeof(double)) return false;
+  if (view.format == nullptr) return true;
+  const char *format = view.format;
+  if (*format == '@' || *format == '=' || *format == '<') ++format;
+  return format[0] == 'd' && format[1] == '\0';
+}
+
+// копия двумерного буфера с произвольными шагами
+bool CopyFromBuffer(PyObject *object, S21Matrix &out) {
+  Py_buffer view;
+  if (PyObject_GetBuffer(object, &view, PyBUF_RECORDS_RO) != 0) return false;
+  bool ok = view.ndim == 2 && IsDoubleFormat(view);
+  if (!ok) {
+    PyErr_SetString(PyExc_TypeError,
+                    "Expected a two-dimensional buffer of float64.");
+  } else {
+    try {
+      out = S21Matrix(static_cast<int>(view.shape[0]),
+                      static_cast<int>(view.shape[1]));
+      const char *base = static_cast<const char *>(view.buf);
+      for (int i = 0; i < out.getRows(); ++i) {
+        for (int j = 0; j < out.getCols(); ++j) {
+          std::memcpy(&out(i, j),
+                      base + i * view.strides[0] + j * view.strides[1],
+                      sizeof(double));
+        }
+      }
+    } catch (...) {
+      SetError();
+      ok = false;
+    }
+  }
+  PyBuffer_Release(&view);
+  return ok;
+}
+
+// копия вложенных последовательностей чисел
+bool CopyFromSequence(PyObject *object, S21Matrix &out) {
+  PyObject *rows = PySequence_Fast(object, "Expected a buffer or a sequence.");
+  if (rows == nullptr) return false;
+  bool ok = true;
+  std::vector<std::vector<double>> values;
+  for (Py_ssize_t i = 0; ok && i < PySequence_Fast_GET_SIZE(rows); ++i) {
+    PyObject *row = PySequence_Fast(PySequence_Fast_GET_ITEM(rows, i),
+                                    "Matrix rows must be sequences.");
+    if (row == nullptr) {
+      ok = false;
+      break;
+    }
+    values.emplace_back();
+    for (Py_ssize_t j = 0; ok && j < PySequence_Fast_GET_SIZE(row); ++j) {
+      double value = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(row, j));
+      ok = !(value == -1.0 && PyErr_Occurred());
+      values.back().push_back(value);
+    }
+    Py_DECREF(row);
+  }
+  Py_DECREF(rows);
+  if (!ok) return false;
+  try {
+    int cols = values.empty() ? 0 : static_cast<int>(values[0].size());
+    for (const std::vector<double> &row : values) {
+      if (static_cast<int>(row.size()) != cols) {
+        throw std::invalid_argument("Matrix rows must have the same length.");
+      }
+    }
+    out = S21Matrix(static_cast<int>(values.size()), cols);
+    for (int i = 0; i < out.getRows(); ++i) {
+      std::copy(values[i].begin(), values[i].end(), out.getMatrix()[i]);
+    }
+  } catch (...) {
+    SetError();
+    return false;
+  }
+  return true;
+}
+
+// Без копирования, если object отдаёт записываемый C-непрерывный
+// двумерный буфер float64 и копия не запрошена
+bool InitFromObject(S21PyMatrix *self, PyObject *object, bool copy) {
+  if (!copy && PyObject_CheckBuffer(object)) {
+    Py_buffer view;
+    const int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE;
+    if (PyObject_GetBuffer(object, &view, flags) == 0) {
+      if (view.ndim == 2 && IsDoubleFormat(view) && view.shape[0] > 0 &&
+          view.shape[1] > 0) {
+        try {
+          *self->matrix = S21Matrix::View(static_cast<double *>(view.buf),
+                                          static_cast<int>(view.shape[0]),
+                                          static_cast<int>(view.shape[1]));
+        } catch (...) {
+          PyBuffer_Release(&view);
+          SetError();
+          return false;
+        }
+        self->source = view;
+        return true;
+      }
+      PyBuffer_Release(&view);
+    } else {
+      PyErr_Clear();
+    }
+  }
+  S21Matrix value;
+  if (PyObject_CheckBuffer(object) ? !CopyFromBuffer(object, value)
+                                   : !CopyFromSequence(object, value)) {
+    return false;
+  }
+  *self->matrix = std::move(value);
+  return true;
+}
+
+//============= Тип S21Matrix =================================================
+
+PyObject *MatrixNew(PyTypeObject *type, PyObject *, PyObject *) {
+  PyObject *object = type->tp_alloc(type, 0);
+  if (object == nullptr) return nullptr;
+  S21PyMatrix *self = AsMatrix(object);
+  try {
+    self->matrix = new S21Matrix();
+  } catch (...) {
+    Py_DECREF(object);
+    return SetError();
+  }
+  return object;
+}
+
+// S21Matrix(), S21Matrix(rows, cols), S21Matrix(obj, copy=False)
+int MatrixInit(PyObject *object, PyObject *args, PyObject *kwargs) {
+  S21PyMatrix *self = AsMatrix(object);
+  if (self->pins > 0) {
+    PyErr_SetString(PyExc_BufferError,
+                    "Cannot reinitialize a matrix while its memory is "
+                    "exported.");
+    return -1;
+  }
+  // первые два аргумента только позиционные
+  static const char *kKeywords[] = {"", "", "copy", nullptr};
+  PyObject *first = nullptr, *second = nullptr;
+  int copy = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OO$p",
+                                   const_cast<char **>(kKeywords), &first,
+                                   &second, &copy)) {
+    return -1;
+  }
+  *self->matrix = S21Matrix();
+  ReleaseSource(self);
+  if (first == nullptr) return 0;
+  if (second == nullptr && !PyLong_Check(first)) {
+    return InitFromObject(self, first, copy) ? 0 : -1;
+  }
+  int rows = 0, cols = -1;
+  if (!ToInt(first, rows) || (second != nullptr && !ToInt(second, cols))) {
+    return -1;
+  }
+  try {
+    *self->matrix = S21Matrix(rows, cols);
+  } catch (...) {
+    SetError();
+    return -1;
+  }
+  return 0;
+}
+
+void MatrixDealloc(PyObject *object) {
+  S21PyMatrix *self = AsMatrix(object);
+  PyTypeObject *type = Py_TYPE(object);
+  // сначала матрица, которая может смотреть в память source
+  delete self->matrix;
+  ReleaseSource(self);
+  type->tp_free(object);
+  Py_DECREF(type);
+}
+
+int MatrixGetBuffer(PyObject *object, Py_buffer *view, int flags) {
+  S21PyMatrix *self = AsMatrix(object);
+  S21Matrix &m = *self->matrix;
+  if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS && m.getRows() > 1 &&
+      m.getCols() > 1) {
+    PyErr_SetString(PyExc_BufferError, "Matrix storage is row-major.");
+    view->obj = nullptr;
+    return -1;
+  }
+  try {
+    // запись через буфер не проходит через копирование при записи
+    m.Detach();
+  } catch (...) {
+    view->obj = nullptr;
+    SetError();
+    return -1;
+  }
+  self->shape[0] = m.getRows();
+  self->shape[1] = m.getCols();
+  self->strides[0] = static_cast<Py_ssize_t>(m.getCols()) * sizeof(double);
+  self->strides[1] = sizeof(double);
+  view->obj = Py_NewRef(object);
+  view->buf = m.getMatrix()[0];
+  view->len = self->shape[0] * self->shape[1] * sizeof(double);
+  view->readonly = 0;
+  view->itemsize = sizeof(double);
+  view->format = (flags & PyBUF_FORMAT) ? const_cast<char *>("d") : nullptr;
+  view->ndim = 2;
+  view->shape = (flags & PyBUF_ND) ? self->shape : nullptr;
+  view->strides = (flags & PyBUF_STRIDES) ? self->strides : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  ++self->pins;
+  return 0;
+}
+
+void MatrixReleaseBuffer(PyObject *object, Py_buffer *) {
+  --AsMatrix(object)->pins;
+}
+
+// Для NumPy без протокола буфера. data - memoryview матрицы, а не сырой
+// адрес: массив держит его и тем самым закрепляет хранилище, пока жив.
+PyObject *MatrixArrayInterface(PyObject *object, void *) {
+  S21Matrix &m = *AsMatrix(object)->matrix;
+  PyObject *data = PyMemoryView_FromObject(object);
+  if (data == nullptr) return nullptr;
+  return Py_BuildValue("{s:(ii),s:s,s:N,s:i}", "shape", m.getRows(),
+                       m.getCols(), "typestr", "<f8", "data", data,
+                       "version", 3);
+}
+
+PyObject *MatrixGetRows(PyObject *object, void *) {
+  return PyLong_FromLong(AsMatrix(object)->matrix->getRows());
+}
+
+PyObject *MatrixGetCols(PyObject *object, void *) {
+  return PyLong_FromLong(AsMatrix(object)->matrix->getCols());
+}
+
+PyObject *MatrixIsView(PyObject *object, void *) {
+  return PyBool_FromLong(AsMatrix(object)->matrix->IsView());
+}
+
+// rows и cols меняются через копию, как setRows/setCols
+int SetSize(PyObject *object, PyObject *value, bool rows) {
+  if (value == nullptr) {
+    PyErr_SetString(PyExc_AttributeError, "Cannot delete matrix size.");
+    return -1;
+  }
+  int size = 0;
+  if (!ToInt(value, size)) return -1;
+  S21PyMatrix *self = AsMatrix(object);
+  try {
+    S21Matrix resized(*self->matrix);
+    if (rows) {
+      resized.setRows(size);
+    } else {
+      resized.setCols(size);
+    }
+    return Replace(self, std::move(resized)) ? 0 : -1;
+  } catch (...) {
+    SetError();
+    return -1;
+  }
+}
+
+int MatrixSetRows(PyObject *object, PyObject *value, void *) {
+  return SetSize(object, value, true);
+}
+
+int MatrixSetCols(PyObject *object, PyObject *value, void *) {
+  return SetSize(object, value, false);
+}
+
+// m[i, j]
+bool ParseIndex(PyObject *key, int &i, int &j) {
+  if (!PyTuple_Check(key) || PyTuple_GET_SIZE(key) != 2) {
+    PyErr_SetString(PyExc_TypeError, "Matrix index must be a pair (i, j).");
+    return false;
+  }
+  return ToInt(PyTuple_GET_ITEM(key, 0), i) &&
+         ToInt(PyTuple_GET_ITEM(key, 1), j);
+}
+
+PyObject *MatrixGetItem(PyObject *object, PyObject *key) {
+  int i = 0, j = 0;
+  if (!ParseIndex(key, i, j)) return nullptr;
+  try {
+    const S21Matrix &m = *AsMatrix(object)->matrix;
+    return PyFloat_FromDouble(m(i, j));
+  } catch (...) {
+    return SetError();
+  }
+}
+
+int MatrixSetItem(PyObject *object, PyObject *key, PyObject *value) {
+  int i = 0, j = 0;
+  if (value == nullptr) {
+    PyErr_SetString(PyExc_TypeError, "Cannot delete matrix elements.");
+    return -1;
+  }
+  if (!ParseIndex(key, i, j)) return -1;
+  double number = PyFloat_AsDouble(value);
+  if (number == -1.0 && PyErr_Occurred()) return -1;
+  try {
+    (*AsMatrix(object)->matrix)(i, j) = number;
+  } catch (...) {
+    SetError();
+    return -1;
+  }
+  return 0;
+}
+
+PyObject *MatrixRepr(PyObject *object) {
+  S21Matrix &m = *AsMatrix(object)->matrix;
+  return PyUnicode_FromFormat("S21Matrix(%d, %d)", m.getRows(), m.getCols());
+}
+
+//============= Операции ======================================================
+
+enum class BinaryOp { kSum, kSub, kMul };
+
+S21Matrix Compute(BinaryOp op, const S21Matrix &a, const S21Matrix &b) {
+  switch (op) {
+    case BinaryOp::kSum:
+      return a + b;
+    case BinaryOp::kSub:
+      return a - b;
+    default:
+      return a * b;
+  }
+}
+
+// matrix op matrix без GIL; false и исключение Python при ошибке
+bool BinaryMatrix(BinaryOp op, PyObject *left, PyObject *right,
+                  S21Matrix &result) {
+  S21PyMatrix *a = AsMatrix(left), *b = AsMatrix(right);
+  return RunUnlocked(
+      {a, b}, [&] { result = Compute(op, *a->matrix, *b->matrix); });
+}
+
+// matrix * number и number * matrix
+bool ScaleMatrix(PyObject *matrix, PyObject *number, S21Matrix &result) {
+  double factor = PyFloat_AsDouble(number);
+  if (factor == -1.0 && PyErr_Occurred()) return false;
+  S21PyMatrix *m = AsMatrix(matrix);
+  return RunUnlocked({m}, [&] {
+    result = *m->matrix;
+    result.MulNumber(factor);
+  });
+}
+
+PyObject *Binary(BinaryOp op, PyObject *left, PyObject *right) {
+  S21Matrix result;
+  bool ok;
+  if (IsMatrix(left) && IsMatrix(right)) {
+    ok = BinaryMatrix(op, left, right, result);
+  } else if (op == BinaryOp::kMul && IsMatrix(left) &&
+             PyNumber_Check(right)) {
+    ok = ScaleMatrix(left, right, result);
+  } else if (op == BinaryOp::kMul && IsMatrix(right) &&
+             PyNumber_Check(left)) {
+    ok = ScaleMatrix(right, left, result);
+  } else {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+  return ok ? NewMatrix(std::move(result)) : nullptr;
+}
+
+PyObject *InPlace(BinaryOp op, PyObject *left, PyObject *right) {
+  S21Matrix result;
+  bool ok;
+  if (IsMatrix(right)) {
+    ok = BinaryMatrix(op, left, right, result);
+  } else if (op == BinaryOp::kMul && PyNumber_Check(right)) {
+    ok = ScaleMatrix(left, right, result);
+  } else {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+  if (!ok || !Replace(AsMatrix(left), std::move(result))) return nullptr;
+  return Py_NewRef(left);
+}
+
+PyObject *MatrixAdd(PyObject *a, PyObject *b) {
+  return Binary(BinaryOp::kSum, a, b);
+}
+PyObject *MatrixSubtract(PyObject *a, PyObject *b) {
+  return Binary(BinaryOp::kSub, a, b);
+}
+PyObject *MatrixMultiply(PyObject *a, PyObject *b) {
+  return Binary(BinaryOp::kMul, a, b);
+}
+PyObject *MatrixMatMul(PyObject *a, PyObject *b) {
+  if (!IsMatrix(a) || !IsMatrix(b)) Py_RETURN_NOTIMPLEMENTED;
+  return Binary(BinaryOp::kMul, a, b);
+}
+PyObject *MatrixInPlaceAdd(PyObject *a, PyObject *b) {
+  return InPlace(BinaryOp::kSum, a, b);
+}
+PyObject *MatrixInPlaceSubtract(PyObject *a, PyObject *b) {
+  return InPlace(BinaryOp::kSub, a, b);
+}
+PyObject *MatrixInPlaceMultiply(PyObject *a, PyObject *b) {
+  return InPlace(BinaryOp::kMul, a, b);
+}
+PyObject *MatrixInPlaceMatMul(PyObject *a, PyObject *b) {
+  if (!IsMatrix(b)) Py_RETURN_NOTIMPLEMENTED;
+  return InPlace(BinaryOp::kMul, a, b);
+}
+
+PyObject *MatrixCompare(PyObject *a, PyObject *b, int op) {
+  if (!IsMatrix(b) || (op != Py_EQ && op != Py_NE)) {
+    Py_RETURN_NOTIMPLEMENTED;
+  }
+  bool equal = false;
+  S21PyMatrix *left = AsMatrix(a), *right = AsMatrix(b);
+  if (!RunUnlocked({left, right},
+                   [&] { equal = left->matrix->EqMatrix(*right->matrix); })) {
+    return nullptr;
+  }
+  return PyBool_FromLong(equal == (op == Py_EQ));
+}
+
+// Методы без аргументов, возвращающие матрицу или число
+template <typename Op>
+PyObject *UnaryMatrix(PyObject *object, Op op) {
+  S21PyMatrix *self = AsMatrix(object);
+  S21Matrix result;
+  if (!RunUnlocked({self}, [&] { result = op(*self->matrix); })) {
+    return nullptr;
+  }
+  return NewMatrix(std::move(result));
+}
+
+template <typename Op>
+PyObject *UnaryNumber(PyObject *object, Op op) {
+  S21PyMatrix *self = AsMatrix(object);
+  double result = 0.0;
+  if (!RunUnlocked({self}, [&] { result = op(*self->matrix); })) {
+    return nullptr;
+  }
+  return PyFloat_FromDouble(result);
+}
+
+PyObject *MatrixCopy(PyObject *self, PyObject *) {
+  return UnaryMatrix(self, [](const S21Matrix &m) { return S21Matrix(m); });
+}
+PyObject *MatrixTranspose(PyObject *self, PyObject *) {
+  return UnaryMatrix(self, [](const S21Matrix &m) { return m.Transpose(); });
+}
+PyObject *MatrixCalcComplements(PyObject *self, PyObject *) {
+  return UnaryMatrix(self,
+                     [](const S21Matrix &m) { return m.CalcComplements(); });
+}
+// precision="double" или "mixed", как S21Precision
+bool ToPrecision(const char *name, S21Precision &precision) {
+  if (name == nullptr || std::strcmp(name, "double") == 0) {
+    precision = S21Precision::kDouble;
+  } else if (std::strcmp(name, "mixed") == 0) {
+    precision = S21Precision::kMixed;
+  } else {
+    PyErr_SetString(PyExc_ValueError,
+                    "precision must be 'double' or 'mixed'.");
+    return false;
+  }
+  return true;
+}
+
+PyObject *MatrixInverse(PyObject *self, PyObject *args, PyObject *kwargs) {
+  static const char *kKeywords[] = {"precision", nullptr};
+  const char *name = nullptr;
+  S21Precision precision = S21Precision::kDouble;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|$s",
+                                   const_cast<char **>(kKeywords), &name) ||
+      !ToPrecision(name, precision)) {
+    return nullptr;
+  }
+  return UnaryMatrix(self, [precision](const S21Matrix &m) {
+    return m.InverseMatrix(precision);
+  });
+}
+PyObject *MatrixDeterminant(PyObject *self, PyObject *) {
+  return UnaryNumber(self, [](const S21Matrix &m) { return m.Determinant(); });
+}
+PyObject *MatrixTrace(PyObject *self, PyObject *) {
+  return UnaryNumber(self, [](const S21Matrix &m) { return m.Trace(); });
+}
+PyObject *MatrixSum(PyObject *self, PyObject *) {
+  return UnaryNumber(self, [](const S21Matrix &m) { return m.Sum(); });
+}
+PyObject *MatrixFrobeniusNorm(PyObject *self, PyObject *) {
+  return UnaryNumber(self,
+                     [](const S21Matrix &m) { return m.FrobeniusNorm(); });
+}
+PyObject *MatrixMaxAbs(PyObject *self, PyObject *) {
+  return UnaryNumber(self, [](const S21Matrix &m) { return m.MaxAbs(); });
+}
+PyObject *MatrixConditionEstimate(PyObject *self, PyObject *) {
+  return UnaryNumber(
+      self, [](const S21Matrix &m) { return m.ConditionEstimate(); });
+}
+
+PyObject *MatrixSolve(PyObject *object, PyObject *args, PyObject *kwargs) {
+  static const char *kKeywords[] = {"", "precision", nullptr};
+  PyObject *other = nullptr;
+  const char *name = nullptr;
+  S21Precision precision = S21Precision::kDouble;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|$s",
+                                   const_cast<char **>(kKeywords), &other,
+                                   &name) ||
+      !ToPrecision(name, precision)) {
+    return nullptr;
+  }
+  if (!IsMatrix(other)) {
+    PyErr_SetString(PyExc_TypeError, "solve() expects an S21Matrix.");
+    return nullptr;
+  }
+  S21PyMatrix *self = AsMatrix(object), *b = AsMatrix(other);
+  S21Matrix result;
+  if (!RunUnlocked({self, b}, [&] {
+        result = self->matrix->Solve(*b->matrix, precision);
+      })) {
+    return nullptr;
+  }
+  return NewMatrix(std::move(result));
+}
+
+PyObject *MatrixPower(PyObject *object, PyObject *exponent) {
+  long long k = PyLong_AsLongLong(exponent);
+  if (k == -1 && PyErr_Occurred()) return nullptr;
+  return UnaryMatrix(object, [k](const S21Matrix &m) { return m.Power(k); });
+}
+
+PyObject *MatrixGetMinor(PyObject *object, PyObject *args) {
+  int row = 0, col = 0;
+  if (!PyArg_ParseTuple(args, "ii", &row, &col)) return nullptr;
+  try {
+    return NewMatrix(AsMatrix(object)->matrix->GetMinor(row, col));
+  } catch (...) {
+    return SetError();
+  }
+}
+
+PyObject *ToList(const std::vector<double> &values) {
+  PyObject *list = PyList_New(static_cast<Py_ssize_t>(values.size()));
+  if (list == nullptr) return nullptr;
+  for (size_t i = 0; i < values.size(); ++i) {
+    PyObject *item = PyFloat_FromDouble(values[i]);
+    if (item == nullptr) {
+      Py_DECREF(list);
+      return nullptr;
+    }
+    PyList_SET_ITEM(list, i, item);
+  }
+  return list;
+}
+
+// eigen_symmetric(vectors=True) возвращает (значения, матрица векторов)
+PyObject *MatrixEigenSymmetric(PyObject *object, PyObject *args,
+                               PyObject *kwargs) {
+  static const char *kKeywords[] = {"vectors", nullptr};
+  int with_vectors = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|$p",
+                                   const_cast<char **>(kKeywords),
+                                   &with_vectors)) {
+    return nullptr;
+  }
+  S21PyMatrix *self = AsMatrix(object);
+  std::vector<double> values;
+  S21Matrix vectors;
+  if (!RunUnlocked({self}, [&] {
+        values = with_vectors ? self->matrix->EigenSymmetric(vectors)
+                              : self->matrix->EigenSymmetric();
+      })) {
+    return nullptr;
+  }
+  if (!with_vectors) return ToList(values);
+  // N передаёт ссылки кортежу и освобождает их при ошибке
+  return Py_BuildValue("(NN)", ToList(values), NewMatrix(std::move(vectors)));
+}
+
+// truncated_svd(rank, oversampling=10, power_iterations=2, seed=0)
+// возвращает (u, s, v)
+PyObject *MatrixTruncatedSvd(PyObject *object, PyObject *args,
+                             PyObject *kwargs) {
+  static const char *kKeywords[] = {"rank", "oversampling", "power_iterations",
+                                    "seed", nullptr};
+  int rank = 0, oversampling = 10, power_iterations = 2;
+  unsigned long long seed = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|iiK",
+                                   const_cast<char **>(kKeywords), &rank,
+                                   &oversampling, &power_iterations, &seed)) {
+    return nullptr;
+  }
+  S21PyMatrix *self = AsMatrix(object);
+  S21SvdResult result;
+  if (!RunUnlocked({self}, [&] {
+        result = self->matrix->TruncatedSvd(rank, oversampling,
+                                            power_iterations, seed);
+      })) {
+    return nullptr;
+  }
+  return Py_BuildValue("(NNN)", NewMatrix(std::move(result.u)),
+                       ToList(result.s), NewMatrix(std::move(result.v)));
+}
+
+PyObject *MatrixToList(PyObject *object, PyObject *) {
+  const S21Matrix &m = *AsMatrix(object)->matrix;
+  PyObject *rows = PyList_New(m.getRows());
+  if (rows == nullptr) return nullptr;
+  for (int i = 0; i < m.getRows(); ++i) {
+    PyObject *row = PyList_New(m.getCols());
+    if (row == nullptr) {
+      Py_DECREF(rows);
+      return nullptr;
+    }
+    for (int j = 0; j < m.getCols(); ++j) {
+      PyList_SET_ITEM(row, j, PyFloat_FromDouble(m(i, j)));
+    }
+    PyList_SET_ITEM(rows, i, row);
+  }
+  return rows;
+}
+
+// sum_matrix, sub_matrix, mul_matrix, mul_number меняют матрицу на месте
+PyObject *MatrixSumMatrix(PyObject *self, PyObject *other) {
+  if (!IsMatrix(other)) {
+    PyErr_SetString(PyExc_TypeError, "sum_matrix() expects an S21Matrix.");
+    return nullptr;
+  }
+  PyObject *result = InPlace(BinaryOp::kSum, self, other);
+  Py_XDECREF(result);
+  return result == nullptr ? nullptr : Py_NewRef(Py_None);
+}
+PyObject *MatrixSubMatrix(PyObject *self, PyObject *other) {
+  if (!IsMatrix(other)) {
+    PyErr_SetString(PyExc_TypeError, "sub_matrix() expects an S21Matrix.");
+    return nullptr;
+  }
+  PyObject *result = InPlace(BinaryOp::kSub, self, other);
+  Py_XDECREF(result);
+  return result == nullptr ? nullptr : Py_NewRef(Py_None);
+}
+PyObject *MatrixMulMatrix(PyObject *self, PyObject *other) {
+  if (!IsMatrix(other)) {
+    PyErr_SetString(PyExc_TypeError, "mul_matrix() expects an S21Matrix.");
+    return nullptr;
+  }
+  PyObject *result = InPlace(BinaryOp::kMul, self, other);
+  Py_XDECREF(result);
+  return result == nullptr ? nullptr : Py_NewRef(Py_None);
+}
+PyObject *MatrixMulNumber(PyObject *self, PyObject *number) {
+  if (!PyNumber_Check(number)) {
+    PyErr_SetString(PyExc_TypeError, "mul_number() expects a number.");
+    return nullptr;
+  }
+  PyObject *result = InPlace(BinaryOp::kMul, self, number);
+  Py_XDECREF(result);
+  return result == nullptr ? nullptr : Py_NewRef(Py_None);
+}
+
+PyObject *MatrixEqMatrix(PyObject *self, PyObject *other) {
+  if (!IsMatrix(other)) {
+    PyErr_SetString(PyExc_TypeError, "eq_matrix() expects an S21Matrix.");
+    return nullptr;
+  }
+  return MatrixCompare(self, other, Py_EQ);
+}
+
+PyObject *MatrixLoadText(PyObject *, PyObject *path) {
+  const char *name = PyUnicode_AsUTF8(path);
+  if (name == nullptr) return nullptr;
+  S21Matrix result;
+  if (!RunUnlocked({}, [&] { result = S21Matrix::LoadText(name); })) {
+    return nullptr;
+  }
+  return NewMatrix(std::move(result));
+}
+
+PyObject *MatrixSaveText(PyObject *object, PyObject *path) {
+  const char *name = PyUnicode_AsUTF8(path);
+  if (name == nullptr) return nullptr;
+  S21PyMatrix *self = AsMatrix(object);
+  if (!RunUnlocked({self}, [&] { self->matrix->SaveText(name); })) {
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
+// методы с ключевыми аргументами хранятся в PyMethodDef как PyCFunction
+PyCFunction WithKeywords(PyCFunctionWithKeywords function) {
+  return reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(function));
+}
+
+PyMethodDef kMatrixMethods[] = {
+    {"copy", MatrixCopy, METH_NOARGS, "Deep copy that owns its storage."},
+    {"tolist", MatrixToList, METH_NOARGS, "Elements as nested lists."},
+    {"transpose", MatrixTranspose, METH_NOARGS, nullptr},
+    {"determinant", MatrixDeterminant, METH_NOARGS, nullptr},
+    {"calc_complements", MatrixCalcComplements, METH_NOARGS, nullptr},
+    {"inverse_matrix", WithKeywords(MatrixInverse),
+     METH_VARARGS | METH_KEYWORDS, "precision='double' or 'mixed'."},
+    {"solve", WithKeywords(MatrixSolve), METH_VARARGS | METH_KEYWORDS,
+     "Solution X of self * X = b, precision='double' or 'mixed'."},
+    {"trace", MatrixTrace, METH_NOARGS, nullptr},
+    {"sum", MatrixSum, METH_NOARGS, nullptr},
+    {"frobenius_norm", MatrixFrobeniusNorm, METH_NOARGS, nullptr},
+    {"max_abs", MatrixMaxAbs, METH_NOARGS, nullptr},
+    {"condition_estimate", MatrixConditionEstimate, METH_NOARGS, nullptr},
+    {"eigen_symmetric", WithKeywords(MatrixEigenSymmetric),
+     METH_VARARGS | METH_KEYWORDS,
+     "Eigenvalues; with vectors=True a pair (values, vectors)."},
+    {"truncated_svd", WithKeywords(MatrixTruncatedSvd),
+     METH_VARARGS | METH_KEYWORDS,
+     "Top singular triplets (u, s, v) by the randomized method."},
+    {"power", MatrixPower, METH_O, nullptr},
+    {"get_minor", MatrixGetMinor, METH_VARARGS, nullptr},
+    {"eq_matrix", MatrixEqMatrix, METH_O, nullptr},
+    {"sum_matrix", MatrixSumMatrix, METH_O, nullptr},
+    {"sub_matrix", MatrixSubMatrix, METH_O, nullptr},
+    {"mul_matrix", MatrixMulMatrix, METH_O, nullptr},
+    {"mul_number", MatrixMulNumber, METH_O, nullptr},
+    {"save_text", MatrixSaveText, METH_O, nullptr},
+    {"load_text", MatrixLoadText, METH_O | METH_STATIC, nullptr},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyGetSetDef kMatrixGetSet[] = {
+    {"rows", MatrixGetRows, MatrixSetRows, nullptr, nullptr},
+    {"cols", MatrixGetCols, MatrixSetCols, nullptr, nullptr},
+    {"is_view", MatrixIsView, nullptr,
+     "True if the matrix works in the memory of another object.", nullptr},
+    {"__array_interface__", MatrixArrayInterface, nullptr, nullptr, nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+PyType_Slot kMatrixSlots[] = {
+    {Py_tp_new, reinterpret_cast<void *>(MatrixNew)},
+    {Py_tp_init, reinterpret_cast<void *>(MatrixInit)},
+    {Py_tp_dealloc, reinterpret_cast<void *>(MatrixDealloc)},
+    {Py_tp_repr, reinterpret_cast<void *>(MatrixRepr)},
+    {Py_tp_richcompare, reinterpret_cast<void *>(MatrixCompare)},
+    {Py_tp_methods, kMatrixMethods},
+    {Py_tp_getset, kMatrixGetSet},
+    {Py_mp_subscript, reinterpret_cast<void *>(MatrixGetItem)},
+    {Py_mp_ass_subscript, reinterpret_cast<void *>(MatrixSetItem)},
+    {Py_nb_add, reinterpret_cast<void *>(MatrixAdd)},
+    {Py_nb_subtract, reinterpret_cast<void *>(MatrixSubtract)},
+    {Py_nb_multiply, reinterpret_cast<void *>(MatrixMultiply)},
+    {Py_nb_matrix_multiply, reinterpret_cast<void *>(MatrixMatMul)},
+    {Py_nb_inplace_add, reinterpret_cast<void *>(MatrixInPlaceAdd)},
+    {Py_nb_inplace_subtract, reinterpret_cast<void *>(MatrixInPlaceSubtract)},
+    {Py_nb_inplace_multiply, reinterpret_cast<void *>(MatrixInPlaceMultiply)},
+    {Py_nb_inplace_matrix_multiply,
+     reinterpret_cast<void *>(MatrixInPlaceMatMul)},
+    {Py_bf_getbuffer, reinterpret_cast<void *>(MatrixGetBuffer)},
+    {Py_bf_releasebuffer, reinterpret_cast<void *>(MatrixReleaseBuffer)},
+    {0, nullptr}};
+
+PyType_Spec kMatrixSpec = {"s21_matrix.S21Matrix", sizeof(S21PyMatrix), 0,
+                           Py_TPFLAGS_DEFAULT, kMatrixSlots};
+
+PyModuleDef kModule = {PyModuleDef_HEAD_INIT,
+                       "s21_matrix",
+                       "Bindings for the S21Matrix library.",
+                       -1,
+                       nullptr,
+                       nullptr,
+                       nullptr,
+                       nullptr,
+                       nullptr};
+}  // namespace
+
+PyMODINIT_FUNC PyInit_s21_matrix() {
+  PyObject *module = PyModule_Create(&kModule);
+  if (module == nullptr) return nullptr;
+  PyObject *type = PyType_FromSpec(&kMatrixSpec);
+  if (type == nullptr || PyModule_AddObjectRef(module, "S21Matrix", type) < 0) {
+    Py_XDECREF(type);
+    Py_DECREF(module);
+    return nullptr;
+  }
+  g_matrix_type = reinterpret_cast<PyTypeObject *>(type);
+  return module;
+}
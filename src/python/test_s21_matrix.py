@@ -0,0 +1,195 @@
+import os
+import struct
+import tempfile
+import threading
+import types
+import unittest
+
+from s21_matrix import S21Matrix
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+
+def fill(m, seed):
+    for i in range(m.rows):
+        for j in range(m.cols):
+            m[i, j] = ((i * 31 + j * 17 + seed * 7) % 23) / 4.0 - 2.5
+
+
+def double_buffer(rows, cols):
+    return memoryview(bytearray(8 * rows * cols)).cast("d", [rows, cols])
+
+
+class S21MatrixPythonTest(unittest.TestCase):
+    def test_elements_and_operations(self):
+        a = S21Matrix([[2.0, 1.0], [1.0, 3.0]])
+        b = S21Matrix(2, 2)
+        b[0, 0], b[1, 1] = 1.0, -1.0
+        self.assertEqual((a + b).tolist(), [[3.0, 1.0], [1.0, 2.0]])
+        self.assertEqual((a - b).tolist(), [[1.0, 1.0], [1.0, 4.0]])
+        self.assertEqual((a @ b).tolist(), [[2.0, -1.0], [1.0, -3.0]])
+        self.assertEqual((2 * a).tolist(), (a * 2.0).tolist())
+        self.assertAlmostEqual(a.determinant(), 5.0)
+        self.assertTrue(a @ a.inverse_matrix() == S21Matrix([[1, 0], [0, 1]]))
+        self.assertEqual(a.transpose(), a)
+        self.assertEqual(a.trace(), 5.0)
+        self.assertEqual(a.calc_complements().tolist(),
+                         [[3.0, -1.0], [-1.0, 2.0]])
+        with self.assertRaises(ValueError):
+            a + S21Matrix(3, 3)
+        with self.assertRaises(IndexError):
+            a[2, 0]
+
+    def test_int_arguments_are_not_truncated(self):
+        # 2**32 + 2 раньше усекалось до 2
+        big = 2 ** 32 + 2
+        with self.assertRaises(OverflowError):
+            S21Matrix(big, 2)
+        with self.assertRaises(OverflowError):
+            S21Matrix(2, 2 ** 70)
+        a = S21Matrix(3, 3)
+        with self.assertRaises(OverflowError):
+            a[big, 0]
+        with self.assertRaises(OverflowError):
+            a[0, big] = 1.0
+        with self.assertRaises(OverflowError):
+            a.rows = big
+        self.assertEqual((a.rows, a.cols), (3, 3))
+
+    def test_precision_eigenvectors_and_svd(self):
+        a = S21Matrix([[4.0, 1.0], [1.0, 3.0]])
+        b = S21Matrix([[1.0], [2.0]])
+        mixed = a.solve(b, precision="mixed")
+        self.assertTrue(a @ mixed == b)
+        self.assertTrue(a.inverse_matrix(precision="mixed") ==
+                        a.inverse_matrix())
+        with self.assertRaises(ValueError):
+            a.solve(b, precision="half")
+
+        values, vectors = a.eigen_symmetric(vectors=True)
+        self.assertEqual(values, a.eigen_symmetric())
+        self.assertEqual((vectors.rows, vectors.cols), (2, 2))
+        for k in range(2):
+            column = S21Matrix([[vectors[0, k]], [vectors[1, k]]])
+            self.assertTrue(a @ column == column * values[k])
+
+        u, s, v = a.truncated_svd(2, seed=1)
+        self.assertEqual(len(s), 2)
+        sigma = S21Matrix([[s[0], 0.0], [0.0, s[1]]])
+        self.assertTrue(u @ sigma @ v.transpose() == a)
+
+    def test_in_place_operations_keep_storage(self):
+        a = S21Matrix(3, 3)
+        fill(a, 1)
+        expected = a + a
+        view = memoryview(a)
+        a += a
+        self.assertEqual(a, expected)
+        self.assertEqual(view[1, 2], a[1, 2])
+        # при выданном буфере размер менять нельзя
+        with self.assertRaises(BufferError):
+            a.rows = 4
+        view.release()
+        a.rows = 4
+        self.assertEqual(a.rows, 4)
+
+    def test_matrix_exports_its_memory(self):
+        a = S21Matrix(3, 4)
+        view = memoryview(a)
+        self.assertEqual((view.format, view.shape), ("d", (3, 4)))
+        view[2, 1] = 7.5
+        self.assertEqual(a[2, 1], 7.5)
+        a[0, 3] = -1.0
+        self.assertEqual(view[0, 3], -1.0)
+        view.release()
+        interface = a.__array_interface__
+        self.assertEqual(interface["shape"], (3, 4))
+        self.assertEqual(interface["typestr"], "<f8")
+        # data держит буфер: пока он жив, хранилище не заменяется
+        with self.assertRaises(BufferError):
+            a.rows = 4
+        interface["data"].release()
+        del interface
+        a.rows = 4
+
+    def test_matrix_wraps_foreign_memory(self):
+        buffer = double_buffer(3, 3)
+        m = S21Matrix(buffer)
+        self.assertTrue(m.is_view)
+        m[1, 1] = 4.0
+        self.assertEqual(buffer[1, 1], 4.0)
+        buffer[0, 2] = 2.5
+        self.assertEqual(m[0, 2], 2.5)
+        m.mul_number(2.0)
+        self.assertEqual(buffer[1, 1], 8.0)
+
+        copied = S21Matrix(buffer, copy=True)
+        self.assertFalse(copied.is_view)
+        copied[1, 1] = 0.0
+        self.assertEqual(buffer[1, 1], 8.0)
+        # только для чтения или не float64 - копия
+        readonly = S21Matrix(memoryview(bytes(buffer)).cast("d", [3, 3]))
+        self.assertFalse(readonly.is_view)
+        self.assertEqual(readonly, m)
+        with self.assertRaises(TypeError):
+            S21Matrix(memoryview(bytearray(9)).cast("B", [3, 3]))
+        raw = struct.pack("4d", 1.0, 2.0, 3.0, 4.0)
+        self.assertEqual(S21Matrix(memoryview(raw).cast("d", [2, 2])).tolist(),
+                         [[1.0, 2.0], [3.0, 4.0]])
+
+    def test_text_round_trip(self):
+        a = S21Matrix(4, 5)
+        fill(a, 2)
+        with tempfile.TemporaryDirectory() as directory:
+            path = os.path.join(directory, "a.csv")
+            a.save_text(path)
+            self.assertEqual(S21Matrix.load_text(path), a)
+
+    def test_threads_compute_in_parallel(self):
+        a = S21Matrix(120, 120)
+        fill(a, 3)
+        for i in range(120):
+            a[i, i] += 50.0
+        expected = a.inverse_matrix()
+        results = [None] * 4
+
+        def work(index):
+            results[index] = a.inverse_matrix() @ a
+
+        threads = [threading.Thread(target=work, args=(k,)) for k in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        identity = expected @ a
+        for result in results:
+            self.assertEqual(result, identity)
+
+    @unittest.skipIf(numpy is None, "NumPy is not installed")
+    def test_numpy_shares_memory(self):
+        array = numpy.arange(12, dtype=numpy.float64).reshape(3, 4)
+        m = S21Matrix(array)
+        self.assertTrue(m.is_view)
+        m[2, 3] = -5.0
+        self.assertEqual(array[2, 3], -5.0)
+        back = numpy.asarray(m)
+        self.assertTrue(numpy.shares_memory(back, array))
+        own = S21Matrix(2, 2)
+        holder = types.SimpleNamespace(
+            __array_interface__=own.__array_interface__)
+        exported = numpy.asarray(holder)
+        exported[1, 0] = 3.0
+        self.assertEqual(own[1, 0], 3.0)
+        with self.assertRaises(BufferError):
+            own.rows = 3
+        del exported, holder
+        own.rows = 3
+        product = numpy.asarray(m @ m.transpose())
+        numpy.testing.assert_allclose(product, array @ array.T)
+
+
+if __name__ == "__main__":
+    unittest.main()
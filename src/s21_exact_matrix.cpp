@@ -0,0 +1,388 @@
+#include "s21_exact_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+void Overflow() {
+  throw std::overflow_error("Exact result exceeds the 128-bit integer range.");
+}
+
+S21Integer Mul(S21Integer a, S21Integer b) {
+  S21Integer result;
+  if (__builtin_mul_overflow(a, b, &result)) Overflow();
+  return result;
+}
+
+S21Integer Add(S21Integer a, S21Integer b) {
+  S21Integer result;
+  if (__builtin_add_overflow(a, b, &result)) Overflow();
+  return result;
+}
+
+S21Integer Sub(S21Integer a, S21Integer b) {
+  S21Integer result;
+  if (__builtin_sub_overflow(a, b, &result)) Overflow();
+  return result;
+}
+
+S21Integer Abs(S21Integer a) { return a < 0 ? Sub(0, a) : a; }
+
+S21Integer Gcd(S21Integer a, S21Integer b) {
+  a = Abs(a);
+  b = Abs(b);
+  while (b != 0) {
+    S21Integer r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+// 256-битное значение в дополнительном коде для шага Bareiss: произведение
+// двух миноров может не поместиться в 128 бит, хотя частное помещается
+struct Wide {
+  unsigned __int128 hi, lo;
+};
+
+using Unsigned = unsigned __int128;
+
+Wide Negate(Wide value) {
+  value.hi = ~value.hi;
+  value.lo = ~value.lo + 1;
+  if (value.lo == 0) ++value.hi;
+  return value;
+}
+
+Unsigned Magnitude(S21Integer value) {
+  return value < 0 ? 0 - static_cast<Unsigned>(value)
+                   : static_cast<Unsigned>(value);
+}
+
+Wide WideMul(S21Integer a, S21Integer b) {
+  const Unsigned kMask = ~static_cast<uint64_t>(0);
+  Unsigned ua = Magnitude(a), ub = Magnitude(b);
+  Unsigned a0 = ua & kMask, a1 = ua >> 64, b0 = ub & kMask, b1 = ub >> 64;
+  Unsigned p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  Unsigned middle = (p00 >> 64) + (p01 & kMask) + (p10 & kMask);
+  Wide result{p11 + (p01 >> 64) + (p10 >> 64) + (middle >> 64),
+              (middle << 64) | (p00 & kMask)};
+  return (a < 0) != (b < 0) ? Negate(result) : result;
+}
+
+Wide WideSub(Wide a, Wide b) {
+  Wide result{a.hi - b.hi, a.lo - b.lo};
+  if (a.lo < b.lo) --result.hi;
+  return result;
+}
+
+// точное деление 256-битного значения на 128-битное, частное в 128 битах
+S21Integer WideDiv(Wide value, S21Integer divisor) {
+  bool negative = static_cast<S21Integer>(value.hi) < 0;
+  if (negative) value = Negate(value);
+  negative ^= divisor < 0;
+  Unsigned d = Magnitude(divisor);
+  if (value.hi >= d) Overflow();
+  Unsigned remainder = value.hi, quotient = 0;
+  for (int bit = 127; bit >= 0; --bit) {
+    bool carry = remainder >> 127;
+    remainder = (remainder << 1) | ((value.lo >> bit) & 1);
+    quotient <<= 1;
+    if (carry || remainder >= d) {
+      remainder -= d;
+      quotient |= 1;
+    }
+  }
+  Unsigned limit = static_cast<Unsigned>(1) << 127;
+  if (quotient > limit || (quotient == limit && !negative)) Overflow();
+  return negative ? static_cast<S21Integer>(0 - quotient)
+                  : static_cast<S21Integer>(quotient);
+}
+
+// шаг Bareiss: (pivot * x - left * top) / previous, деление точное.
+// Обычно хватает 128 бит, 256-битный путь - только при переполнении
+S21Integer BareissStep(S21Integer pivot, S21Integer x, S21Integer left,
+                       S21Integer top, S21Integer previous) {
+  S21Integer first, second, difference;
+  if (!__builtin_mul_overflow(pivot, x, &first) &&
+      !__builtin_mul_overflow(left, top, &second) &&
+      !__builtin_sub_overflow(first, second, &difference)) {
+    return difference / previous;
+  }
+  return WideDiv(WideSub(WideMul(pivot, x), WideMul(left, top)), previous);
+}
+
+// поиск ненулевого ведущего элемента в столбце k начиная со строки k,
+// false если столбец нулевой
+bool Pivot(std::vector<S21Integer> &m, int n, int width, int k,
+           bool &swapped) {
+  swapped = false;
+  if (m[static_cast<size_t>(k) * width + k] != 0) return true;
+  for (int p = k + 1; p < n; ++p) {
+    if (m[static_cast<size_t>(p) * width + k] != 0) {
+      std::swap_ranges(m.begin() + static_cast<size_t>(k) * width,
+                       m.begin() + static_cast<size_t>(k + 1) * width,
+                       m.begin() + static_cast<size_t>(p) * width);
+      swapped = true;
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+S21Rational::S21Rational(S21Integer num, S21Integer den) {
+  if (den == 0) throw std::invalid_argument("Denominator must be non-zero.");
+  S21Integer g = Gcd(num, den);
+  num_ = num / g;
+  den_ = den / g;
+  if (den_ < 0) {
+    num_ = Sub(0, num_);
+    den_ = Sub(0, den_);
+  }
+}
+
+S21Rational S21Rational::FromDouble(double value) {
+  if (!std::isfinite(value)) {
+    throw std::invalid_argument("Only finite values can be converted.");
+  }
+  int exponent = 0;
+  double mantissa = std::frexp(value, &exponent);
+  // value = integer * 2^exponent, integer помещается в 53 бита
+  S21Integer integer = static_cast<long long>(std::ldexp(mantissa, 53));
+  exponent -= 53;
+  while (exponent < 0 && integer % 2 == 0 && integer != 0) {
+    integer /= 2;
+    ++exponent;
+  }
+  if (integer == 0) return S21Rational();
+  if (exponent >= 0) {
+    for (; exponent > 0; --exponent) integer = Mul(integer, 2);
+    return S21Rational(integer, 1);
+  }
+  if (exponent < -126) Overflow();
+  return S21Rational(integer, S21Integer(1) << -exponent);
+}
+
+S21Rational S21Rational::operator+(const S21Rational &other) const {
+  S21Integer g = Gcd(den_, other.den_);
+  return S21Rational(
+      Add(Mul(num_, other.den_ / g), Mul(other.num_, den_ / g)),
+      Mul(den_ / g, other.den_));
+}
+
+S21Rational S21Rational::operator-(const S21Rational &other) const {
+  return *this + (-other);
+}
+
+// перекрёстное сокращение до умножения отодвигает переполнение
+S21Rational S21Rational::operator*(const S21Rational &other) const {
+  S21Integer g1 = Gcd(num_, other.den_);
+  S21Integer g2 = Gcd(other.num_, den_);
+  return S21Rational(Mul(num_ / g1, other.num_ / g2),
+                     Mul(den_ / g2, other.den_ / g1));
+}
+
+S21Rational S21Rational::operator/(const S21Rational &other) const {
+  if (other.num_ == 0) throw std::invalid_argument("Division by zero.");
+  return *this * S21Rational(other.den_, other.num_);
+}
+
+S21Rational S21Rational::operator-() const {
+  S21Rational result;
+  result.num_ = Sub(0, num_);
+  result.den_ = den_;
+  return result;
+}
+
+bool S21Rational::operator==(const S21Rational &other) const {
+  return num_ == other.num_ && den_ == other.den_;
+}
+
+bool S21Rational::operator!=(const S21Rational &other) const {
+  return !(*this == other);
+}
+
+double S21Rational::ToDouble() const {
+  return static_cast<double>(num_) / static_cast<double>(den_);
+}
+
+std::string S21Rational::ToString() const {
+  auto digits = [](S21Integer value) {
+    unsigned __int128 magnitude =
+        value < 0 ? 0 - static_cast<unsigned __int128>(value)
+                  : static_cast<unsigned __int128>(value);
+    std::string text;
+    do {
+      text.push_back(static_cast<char>('0' + magnitude % 10));
+      magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) text.push_back('-');
+    return std::string(text.rbegin(), text.rend());
+  };
+  return den_ == 1 ? digits(num_) : digits(num_) + "/" + digits(den_);
+}
+
+S21ExactMatrix::S21ExactMatrix(int rows, int cols) : rows_(rows), cols_(cols) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument("Rows and columns must be positive integers");
+  }
+  data_.resize(static_cast<size_t>(rows) * cols);
+}
+
+S21ExactMatrix::S21ExactMatrix(const S21Matrix &matrix)
+    : S21ExactMatrix(matrix.getRows(), matrix.getCols()) {
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      (*this)(i, j) = S21Rational::FromDouble(matrix(i, j));
+    }
+  }
+}
+
+S21Rational &S21ExactMatrix::operator()(int i, int j) {
+  if (i < 0 || j < 0 || i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  return data_[static_cast<size_t>(i) * cols_ + j];
+}
+
+const S21Rational &S21ExactMatrix::operator()(int i, int j) const {
+  if (i < 0 || j < 0 || i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  return data_[static_cast<size_t>(i) * cols_ + j];
+}
+
+bool S21ExactMatrix::operator==(const S21ExactMatrix &other) const {
+  return rows_ == other.rows_ && cols_ == other.cols_ && data_ == other.data_;
+}
+
+S21Matrix S21ExactMatrix::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  double **a = result.getMatrix();
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) a[i][j] = (*this)(i, j).ToDouble();
+  }
+  return result;
+}
+
+S21ExactMatrix S21ExactMatrix::Multiply(const S21ExactMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrices cannot be multiplied: incompatible dimensions.");
+  }
+  S21ExactMatrix result(rows_, other.cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int k = 0; k < cols_; ++k) {
+      const S21Rational &a_ik = (*this)(i, k);
+      if (a_ik == S21Rational()) continue;
+      for (int j = 0; j < other.cols_; ++j) {
+        result(i, j) = result(i, j) + a_ik * other(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+void S21ExactMatrix::CheckSquare(const std::string &op) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to calculate " + op +
+                                ".");
+  }
+}
+
+// строка i умножается на НОК знаменателей своих элементов, так что
+// det(A) = det(B) / prod(scales), A^-1 = B^-1 * diag(scales)
+std::vector<S21Integer> S21ExactMatrix::ScaledRows(
+    std::vector<S21Integer> &scales) const {
+  std::vector<S21Integer> scaled(data_.size());
+  scales.assign(rows_, 1);
+  for (int i = 0; i < rows_; ++i) {
+    const S21Rational *row = &data_[static_cast<size_t>(i) * cols_];
+    S21Integer lcm = 1;
+    for (int j = 0; j < cols_; ++j) {
+      S21Integer den = row[j].getDenominator();
+      lcm = Mul(lcm / Gcd(lcm, den), den);
+    }
+    for (int j = 0; j < cols_; ++j) {
+      scaled[static_cast<size_t>(i) * cols_ + j] =
+          Mul(row[j].getNumerator(), lcm / row[j].getDenominator());
+    }
+    scales[i] = lcm;
+  }
+  return scaled;
+}
+
+S21Rational S21ExactMatrix::Determinant() const {
+  CheckSquare("determinant");
+  const int n = rows_;
+  std::vector<S21Integer> scales;
+  std::vector<S21Integer> m = ScaledRows(scales);
+  auto at = [&m, n](int i, int j) -> S21Integer & {
+    return m[static_cast<size_t>(i) * n + j];
+  };
+  S21Integer previous = 1;
+  bool negative = false;
+  for (int k = 0; k < n - 1; ++k) {
+    bool swapped = false;
+    if (!Pivot(m, n, n, k, swapped)) return S21Rational();
+    negative ^= swapped;
+    for (int i = k + 1; i < n; ++i) {
+      for (int j = k + 1; j < n; ++j) {
+        at(i, j) = BareissStep(at(k, k), at(i, j), at(i, k), at(k, j),
+                               previous);
+      }
+    }
+    previous = at(k, k);
+  }
+  S21Integer det = negative ? Sub(0, at(n - 1, n - 1)) : at(n - 1, n - 1);
+  S21Rational result(det, 1);
+  for (S21Integer scale : scales) result = result / S21Rational(scale, 1);
+  return result;
+}
+
+// Бездробный метод Гаусса-Жордана над [B | I]: в конце слева d * I,
+// справа d * B^-1, где d = ±det(B)
+S21ExactMatrix S21ExactMatrix::InverseMatrix() const {
+  CheckSquare("inverse");
+  const int n = rows_;
+  const int width = 2 * n;
+  std::vector<S21Integer> scales;
+  std::vector<S21Integer> b = ScaledRows(scales);
+  std::vector<S21Integer> m(static_cast<size_t>(n) * width, 0);
+  auto at = [&m, width](int i, int j) -> S21Integer & {
+    return m[static_cast<size_t>(i) * width + j];
+  };
+  for (int i = 0; i < n; ++i) {
+    std::copy(b.begin() + static_cast<size_t>(i) * n,
+              b.begin() + static_cast<size_t>(i + 1) * n, &at(i, 0));
+    at(i, n + i) = 1;
+  }
+  S21Integer previous = 1;
+  for (int k = 0; k < n; ++k) {
+    bool swapped = false;
+    if (!Pivot(m, n, width, k, swapped)) {
+      throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+    }
+    for (int i = 0; i < n; ++i) {
+      if (i == k) continue;
+      for (int j = 0; j < width; ++j) {
+        if (j == k) continue;
+        at(i, j) = BareissStep(at(k, k), at(i, j), at(i, k), at(k, j),
+                               previous);
+      }
+      at(i, k) = 0;
+    }
+    previous = at(k, k);
+  }
+  S21ExactMatrix inverse(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      inverse(i, j) = S21Rational(at(i, n + j), previous) *
+                      S21Rational(scales[j], 1);
+    }
+  }
+  return inverse;
+}
@@ -0,0 +1,71 @@
+#ifndef S21_EXACT_MATRIX_H
+#define S21_EXACT_MATRIX_H
+
+#include <string>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Точная арифметика на 128-битных целых. Переполнение промежуточного
+// результата бросает std::overflow_error, а не даёт неверный ответ.
+using S21Integer = __int128;
+
+// Несократимая дробь num / den, den > 0
+class S21Rational {
+ public:
+  S21Rational() : num_(0), den_(1) {}
+  S21Rational(long long value) : num_(value), den_(1) {}
+  S21Rational(S21Integer num, S21Integer den);
+  // любое конечное double - двоичная дробь и переводится без потерь
+  static S21Rational FromDouble(double value);
+
+  S21Integer getNumerator() const { return num_; }
+  S21Integer getDenominator() const { return den_; }
+  bool IsInteger() const { return den_ == 1; }
+
+  S21Rational operator+(const S21Rational &other) const;
+  S21Rational operator-(const S21Rational &other) const;
+  S21Rational operator*(const S21Rational &other) const;
+  S21Rational operator/(const S21Rational &other) const;
+  S21Rational operator-() const;
+  bool operator==(const S21Rational &other) const;
+  bool operator!=(const S21Rational &other) const;
+
+  double ToDouble() const;
+  // "num" или "num/den"
+  std::string ToString() const;
+
+ private:
+  S21Integer num_, den_;
+};
+
+// Матрица из рациональных чисел для точных определителя и обратной матрицы.
+// Исключение Гаусса без дробей (Bareiss) выполняет O(n^3) целочисленных
+// операций, и каждое промежуточное значение - минор исходной матрицы.
+class S21ExactMatrix {
+ public:
+  S21ExactMatrix(int rows, int cols);
+  // элементы переводятся без потерь (S21Rational::FromDouble)
+  explicit S21ExactMatrix(const S21Matrix &matrix);
+
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  S21Rational &operator()(int i, int j);
+  const S21Rational &operator()(int i, int j) const;
+  bool operator==(const S21ExactMatrix &other) const;
+
+  S21Matrix ToMatrix() const;
+  S21ExactMatrix Multiply(const S21ExactMatrix &other) const;
+  S21Rational Determinant() const;
+  S21ExactMatrix InverseMatrix() const;
+
+ private:
+  // строки, умноженные на НОК знаменателей строки, и эти множители
+  std::vector<S21Integer> ScaledRows(std::vector<S21Integer> &scales) const;
+  void CheckSquare(const std::string &op) const;
+
+  int rows_, cols_;
+  std::vector<S21Rational> data_;
+};
+
+#endif  // S21_EXACT_MATRIX_H
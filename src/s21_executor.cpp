@@ -0,0 +1,222 @@
+#include "s21_executor.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+
+#include "s21_parallel.h"
+
+namespace {
+// номер рабочего потока текущего потока, -1 для внешних потоков
+thread_local int current_worker = -1;
+}  // namespace
+
+S21Executor &S21Executor::Instance() {
+  static S21Executor executor;
+  return executor;
+}
+
+S21Executor::S21Executor()
+    : queues_(new WorkQueue[kMaxWorkers]),
+      worker_count_(0),
+      queued_(0),
+      stop_(false) {
+  EnsureWorkers(S21GetThreadCount());
+}
+
+S21Executor::~S21Executor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+void S21Executor::Submit(std::function<void()> task) {
+  WorkQueue &queue =
+      current_worker >= 0 ? queues_[current_worker] : injected_;
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  queued_.fetch_add(1);
+  Notify();
+}
+
+void S21Executor::SubmitTo(int worker, std::function<void()> task) {
+  WorkQueue &queue = queues_[worker];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.pinned.push_back(std::move(task));
+  }
+  queue.pinned_count.fetch_add(1);
+  // разбудить нужно именно этот поток
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  cv_.notify_all();
+}
+
+void S21Executor::Notify() {
+  // пустой захват мьютекса исключает потерю пробуждения
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  cv_.notify_one();
+}
+
+bool S21Executor::RunPendingTask() {
+  std::function<void()> task;
+  int self = current_worker;
+  if (self >= 0 && PopPinned(self, task)) {
+    task();
+    return true;
+  }
+  if ((self >= 0 && PopLocal(self, task)) || PopInjected(task) ||
+      Steal(self, task)) {
+    queued_.fetch_sub(1);
+    task();
+    return true;
+  }
+  return false;
+}
+
+bool S21Executor::PopPinned(int index, std::function<void()> &task) {
+  WorkQueue &queue = queues_[index];
+  if (queue.pinned_count.load() == 0) return false;
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.pinned.empty()) return false;
+  task = std::move(queue.pinned.front());
+  queue.pinned.pop_front();
+  queue.pinned_count.fetch_sub(1);
+  return true;
+}
+
+bool S21Executor::PopLocal(int index, std::function<void()> &task) {
+  WorkQueue &queue = queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) return false;
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool S21Executor::PopInjected(std::function<void()> &task) {
+  std::lock_guard<std::mutex> lock(injected_.mutex);
+  if (injected_.tasks.empty()) return false;
+  task = std::move(injected_.tasks.front());
+  injected_.tasks.pop_front();
+  return true;
+}
+
+bool S21Executor::Steal(int thief, std::function<void()> &task) {
+  int count = worker_count_.load();
+  int start = thief >= 0 ? thief + 1 : 0;
+  for (int offset = 0; offset < count; ++offset) {
+    int victim = (start + offset) % count;
+    if (victim == thief) continue;
+    WorkQueue &queue = queues_[victim];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+// пул только растёт: лишние потоки просто простаивают
+void S21Executor::EnsureWorkers(int count) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  count = std::min(count, kMaxWorkers);
+  while (static_cast<int>(workers_.size()) < count) {
+    int index = static_cast<int>(workers_.size());
+    workers_.emplace_back(&S21Executor::WorkerLoop, this, index);
+    worker_count_.store(index + 1);
+    if (!cpus_.empty()) PinWorker(index);
+  }
+}
+
+void S21Executor::PinWorkers(const std::vector<int> &cpus) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cpus_ = cpus;
+  for (int index = 0; index < static_cast<int>(workers_.size()); ++index) {
+    PinWorker(index);
+  }
+}
+
+// вызывается под mutex_
+void S21Executor::PinWorker(int index) {
+#ifndef __linux__
+  // на других системах закрепление недоступно
+  (void)index;
+#else
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (cpus_.empty()) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) CPU_SET(cpu, &set);
+  } else {
+    CPU_SET(cpus_[index % cpus_.size()], &set);
+  }
+  pthread_setaffinity_np(workers_[index].native_handle(), sizeof(set), &set);
+#endif
+}
+
+int S21Executor::getWorkerCount() const { return worker_count_.load(); }
+
+int S21Executor::CurrentWorker() { return current_worker; }
+
+void S21Executor::WorkerLoop(int index) {
+  current_worker = index;
+  for (;;) {
+    if (RunPendingTask()) continue;
+    std::unique_lock<std::mutex> lock(mutex_);
+    WorkQueue &own = queues_[index];
+    cv_.wait(lock, [this, &own] {
+      return stop_ || queued_.load() > 0 || own.pinned_count.load() > 0;
+    });
+    if (stop_ && queued_.load() == 0 && own.pinned_count.load() == 0) return;
+  }
+}
+
+S21TaskGroup::~S21TaskGroup() { Join(); }
+
+void S21TaskGroup::Run(std::function<void()> task) {
+  pending_.fetch_add(1);
+  S21Executor::Instance().Submit(Wrap(std::move(task)));
+}
+
+void S21TaskGroup::RunOn(int worker, std::function<void()> task) {
+  pending_.fetch_add(1);
+  S21Executor::Instance().SubmitTo(worker, Wrap(std::move(task)));
+}
+
+std::function<void()> S21TaskGroup::Wrap(std::function<void()> task) {
+  return [this, task]() {
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+    pending_.fetch_sub(1);
+  };
+}
+
+void S21TaskGroup::Wait() {
+  Join();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+// ожидающий поток помогает пулу, а не блокируется
+void S21TaskGroup::Join() {
+  while (pending_.load() > 0) {
+    if (!S21Executor::Instance().RunPendingTask()) std::this_thread::yield();
+  }
+}
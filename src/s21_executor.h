@@ -0,0 +1,91 @@
+#ifndef S21_EXECUTOR_H
+#define S21_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Общий пул потоков библиотеки с перехватом работы (work stealing).
+// У каждого рабочего потока своя очередь: свои задачи он берёт с конца
+// (LIFO), а простаивающие потоки забирают чужие с начала (FIFO). Задачи
+// из внешних потоков попадают в общую входную очередь.
+class S21Executor {
+ public:
+  static S21Executor &Instance();
+
+  S21Executor(const S21Executor &) = delete;
+  S21Executor &operator=(const S21Executor &) = delete;
+  ~S21Executor();
+
+  void Submit(std::function<void()> task);
+  // задача, которую выполнит только рабочий поток worker (не перехватывается)
+  void SubmitTo(int worker, std::function<void()> task);
+  // выполняет одну ожидающую задачу, false если очереди пусты
+  bool RunPendingTask();
+  void EnsureWorkers(int count);
+  int getWorkerCount() const;
+  // номер рабочего потока, из которого вызвана функция, -1 вне пула
+  static int CurrentWorker();
+  // закрепление потока i за ядром cpus[i % size], пустой список снимает
+  // закрепление
+  void PinWorkers(const std::vector<int> &cpus);
+
+ private:
+  static constexpr int kMaxWorkers = 256;
+
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+    std::deque<std::function<void()>> pinned;
+    std::atomic<int> pinned_count{0};
+  };
+
+  S21Executor();
+  void WorkerLoop(int index);
+  bool PopPinned(int index, std::function<void()> &task);
+  bool PopLocal(int index, std::function<void()> &task);
+  bool PopInjected(std::function<void()> &task);
+  bool Steal(int thief, std::function<void()> &task);
+  void Notify();
+  void PinWorker(int index);
+
+  std::unique_ptr<WorkQueue[]> queues_;
+  WorkQueue injected_;
+  std::atomic<int> worker_count_;
+  std::atomic<int> queued_;
+  std::vector<std::thread> workers_;
+  std::vector<int> cpus_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_;
+};
+
+// Fork/join: Run ставит задачу в пул, Wait дожидается всех задач группы,
+// выполняя в это время задачи пула, и пробрасывает первое исключение
+class S21TaskGroup {
+ public:
+  S21TaskGroup() = default;
+  S21TaskGroup(const S21TaskGroup &) = delete;
+  S21TaskGroup &operator=(const S21TaskGroup &) = delete;
+  ~S21TaskGroup();
+
+  void Run(std::function<void()> task);
+  void RunOn(int worker, std::function<void()> task);
+  void Wait();
+
+ private:
+  void Join();
+  std::function<void()> Wrap(std::function<void()> task);
+
+  std::atomic<int> pending_{0};
+  std::mutex mutex_;
+  std::exception_ptr error_;
+};
+
+#endif  // S21_EXECUTOR_H
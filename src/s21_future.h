@@ -0,0 +1,166 @@
+#ifndef S21_FUTURE_H
+#define S21_FUTURE_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_executor.h"
+
+// Результат асинхронной операции. В отличие от std::future поддерживает
+// продолжения: Then ставит функцию в пул после готовности результата и
+// не занимает поток ожиданием.
+template <typename T>
+class S21Future {
+  static_assert(!std::is_void<T>::value, "S21Future requires a value type");
+
+ public:
+  S21Future() = default;
+
+  bool Valid() const { return state_ != nullptr; }
+
+  bool IsReady() const {
+    CheckValid();
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->ready;
+  }
+
+  // На потоке пула ожидание выполняет другие задачи, как
+  // S21TaskGroup::Join: иначе задачи, ждущие вложенных, могут занять все
+  // потоки, и вложенным не останется ни одного.
+  void Wait() const {
+    CheckValid();
+    if (S21Executor::CurrentWorker() >= 0) {
+      while (!IsReady()) {
+        if (!S21Executor::Instance().RunPendingTask()) {
+          std::this_thread::yield();
+        }
+      }
+      return;
+    }
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->cv.wait(lock, [this] { return state_->ready; });
+  }
+
+  const T &Get() const {
+    Wait();
+    if (state_->error) std::rethrow_exception(state_->error);
+    return *state_->value;
+  }
+
+  template <typename F>
+  auto Then(F func) const -> S21Future<std::invoke_result_t<F, const T &>> {
+    CheckValid();
+    using R = std::invoke_result_t<F, const T &>;
+    S21Future<R> next = S21Future<R>::MakePending();
+    auto state = state_;
+    auto next_state = next.state_;
+    AddContinuation([state, next_state, func]() mutable {
+      if (state->error) {
+        S21Future<R>::Fail(next_state, state->error);
+        return;
+      }
+      try {
+        S21Future<R>::Complete(next_state, func(*state->value));
+      } catch (...) {
+        S21Future<R>::Fail(next_state, std::current_exception());
+      }
+    });
+    return next;
+  }
+
+ private:
+  template <typename U>
+  friend class S21Future;
+  template <typename F>
+  friend auto S21Async(F func) -> S21Future<std::invoke_result_t<F>>;
+
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool ready = false;
+    std::optional<T> value;
+    std::exception_ptr error;
+    std::vector<std::function<void()>> continuations;
+  };
+
+  static S21Future MakePending() {
+    S21Future future;
+    future.state_ = std::make_shared<State>();
+    return future;
+  }
+
+  static void Complete(const std::shared_ptr<State> &state, T value) {
+    std::vector<std::function<void()>> continuations;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->value.emplace(std::move(value));
+      state->ready = true;
+      continuations.swap(state->continuations);
+    }
+    Publish(state, continuations);
+  }
+
+  static void Fail(const std::shared_ptr<State> &state,
+                   std::exception_ptr error) {
+    std::vector<std::function<void()>> continuations;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->error = error;
+      state->ready = true;
+      continuations.swap(state->continuations);
+    }
+    Publish(state, continuations);
+  }
+
+  static void Publish(const std::shared_ptr<State> &state,
+                      std::vector<std::function<void()>> &continuations) {
+    state->cv.notify_all();
+    for (auto &continuation : continuations) {
+      S21Executor::Instance().Submit(std::move(continuation));
+    }
+  }
+
+  void AddContinuation(std::function<void()> continuation) const {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (!state_->ready) {
+        state_->continuations.push_back(std::move(continuation));
+        return;
+      }
+    }
+    S21Executor::Instance().Submit(std::move(continuation));
+  }
+
+  void CheckValid() const {
+    if (!state_) throw std::logic_error("Future has no shared state.");
+  }
+
+  std::shared_ptr<State> state_;
+};
+
+// Запуск функции в пуле библиотеки
+template <typename F>
+auto S21Async(F func) -> S21Future<std::invoke_result_t<F>> {
+  using R = std::invoke_result_t<F>;
+  S21Future<R> future = S21Future<R>::MakePending();
+  auto state = future.state_;
+  S21Executor::Instance().Submit([state, func]() mutable {
+    try {
+      S21Future<R>::Complete(state, func());
+    } catch (...) {
+      S21Future<R>::Fail(state, std::current_exception());
+    }
+  });
+  return future;
+}
+
+#endif  // S21_FUTURE_H
@@ -0,0 +1,150 @@
+#include "s21_inverse_update.h"
+
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix_lu.h"
+
+namespace {
+// LU матрицы a, false если она вырождена
+bool Factor(const S21Matrix &a, S21LUFactor<double> &factor) {
+  const int n = a.getRows();
+  factor.n = n;
+  const double *data = a.getMatrix()[0];
+  factor.lu.assign(data, data + static_cast<size_t>(n) * n);
+  return S21LUDecomposeBlocked(factor);
+}
+
+double FactorDeterminant(const S21LUFactor<double> &factor) {
+  double det = factor.sign;
+  for (int i = 0; i < factor.n; ++i) {
+    det *= factor.lu[static_cast<size_t>(i) * factor.n + i];
+  }
+  return det;
+}
+
+// C = I + V^T W вычислена с ошибкой порядка n * eps * |V|^T |W|; ведущий
+// элемент разложения меньше этой величины не отличим от нуля
+bool NumericallySingular(const S21LUFactor<double> &factor,
+                         const S21Matrix &v, const S21Matrix &w) {
+  S21Matrix abs_v(v), abs_w(w);
+  abs_v.Apply([](double x) { return std::fabs(x); });
+  abs_w.Apply([](double x) { return std::fabs(x); });
+  S21Matrix magnitude(v.getCols(), w.getCols());
+  S21Matrix::Gemm(1.0, abs_v, true, abs_w, false, 0.0, magnitude);
+  const double tolerance =
+      v.getRows() * DBL_EPSILON * (1.0 + magnitude.MaxAbs());
+  for (int i = 0; i < factor.n; ++i) {
+    const double pivot = factor.lu[static_cast<size_t>(i) * factor.n + i];
+    if (std::fabs(pivot) <= tolerance) return true;
+  }
+  return false;
+}
+
+// X = A^-1 * B по готовому разложению A
+S21Matrix SolveFactored(const S21LUFactor<double> &factor,
+                        const S21Matrix &b) {
+  S21Matrix x(b);
+  x.Detach();
+  S21LUSolveBlocked(factor, x.getMatrix()[0], b.getCols());
+  return x;
+}
+}  // namespace
+
+S21UpdatableInverse::S21UpdatableInverse(const S21Matrix &matrix,
+                                         int refactor_interval)
+    : matrix_(matrix),
+      inverse_(matrix.getRows(), matrix.getCols()),
+      determinant_(0.0),
+      refactor_interval_(refactor_interval),
+      updates_(0) {
+  if (matrix.getRows() != matrix.getCols()) {
+    throw std::invalid_argument("Matrix must be square to calculate inverse.");
+  }
+  if (refactor_interval < 0) {
+    throw std::invalid_argument("Refactor interval must be non-negative.");
+  }
+  matrix_.Detach();
+  Refactor();
+}
+
+void S21UpdatableInverse::Refactor() {
+  S21Matrix inverse;
+  double determinant = 0.0;
+  Invert(matrix_, inverse, determinant);
+  inverse_.swap(inverse);
+  determinant_ = determinant;
+  updates_ = 0;
+}
+
+void S21UpdatableInverse::Invert(const S21Matrix &matrix, S21Matrix &inverse,
+                                 double &determinant) {
+  S21LUFactor<double> factor;
+  if (!Factor(matrix, factor)) {
+    throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+  }
+  S21Matrix identity(matrix.getRows(), matrix.getCols());
+  for (int i = 0; i < identity.getRows(); ++i) identity(i, i) = 1.0;
+  inverse = SolveFactored(factor, identity);
+  determinant = FactorDeterminant(factor);
+}
+
+// Всё считается во временных матрицах, состояние меняется только после
+// успешного разложения ёмкостной матрицы C = I + V^T A^-1 U и, если оно
+// положено, переразложения новой матрицы
+void S21UpdatableInverse::Update(const S21Matrix &u, const S21Matrix &v) {
+  const int n = matrix_.getRows();
+  const int k = u.getCols();
+  if (u.getRows() != n || v.getRows() != n || v.getCols() != k) {
+    throw std::invalid_argument(
+        "Update factors must both have size n x k.");
+  }
+  S21Matrix w = inverse_ * u;
+  S21Matrix z(k, n);
+  S21Matrix::Gemm(1.0, v, true, inverse_, false, 0.0, z);
+  S21Matrix capacitance(k, k);
+  for (int i = 0; i < k; ++i) capacitance(i, i) = 1.0;
+  S21Matrix::Gemm(1.0, v, true, w, false, 1.0, capacitance);
+  S21LUFactor<double> factor;
+  if (!Factor(capacitance, factor) || NumericallySingular(factor, v, w)) {
+    throw std::invalid_argument("Update makes the matrix singular.");
+  }
+  S21Matrix correction = SolveFactored(factor, z);
+  S21Matrix inverse = inverse_;
+  S21Matrix matrix = matrix_;
+  S21Matrix::Gemm(-1.0, w, false, correction, false, 1.0, inverse);
+  S21Matrix::Gemm(1.0, u, false, v, true, 1.0, matrix);
+  double determinant = determinant_ * FactorDeterminant(factor);
+  int updates = updates_ + 1;
+  if (refactor_interval_ > 0 && updates >= refactor_interval_) {
+    Invert(matrix, inverse, determinant);
+    updates = 0;
+  }
+  matrix_.swap(matrix);
+  inverse_.swap(inverse);
+  determinant_ = determinant;
+  updates_ = updates;
+}
+
+void S21UpdatableInverse::SetRow(int row, const S21Matrix &values) {
+  const int n = matrix_.getRows();
+  if (values.getRows() != 1 || values.getCols() != n) {
+    throw std::invalid_argument("Row values must have size 1 x n.");
+  }
+  matrix_.CheckIndex(row, 0);
+  S21Matrix u(n, 1), v(n, 1);
+  u(row, 0) = 1.0;
+  for (int j = 0; j < n; ++j) v(j, 0) = values(0, j) - matrix_(row, j);
+  Update(u, v);
+}
+
+void S21UpdatableInverse::SetElement(int row, int col, double value) {
+  const int n = matrix_.getRows();
+  matrix_.CheckIndex(row, col);
+  S21Matrix u(n, 1), v(n, 1);
+  u(row, 0) = 1.0;
+  v(col, 0) = value - matrix_(row, col);
+  Update(u, v);
+}
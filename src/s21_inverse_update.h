@@ -0,0 +1,48 @@
+#ifndef S21_INVERSE_UPDATE_H
+#define S21_INVERSE_UPDATE_H
+
+#include "s21_matrix_oop.h"
+
+// Матрица вместе с обратной и определителем, которые пересчитываются при
+// изменениях малого ранга за O(n^2 k) вместо O(n^3):
+//   (A + U V^T)^-1 = A^-1 - A^-1 U (I + V^T A^-1 U)^-1 V^T A^-1
+//   det(A + U V^T) = det(A) * det(I + V^T A^-1 U)
+// Погрешность обновлений накапливается, поэтому каждые refactor_interval
+// обновлений обратная и определитель вычисляются заново через LU.
+class S21UpdatableInverse {
+ public:
+  static constexpr int kDefaultRefactorInterval = 64;
+
+  // 0 отключает периодическое переразложение
+  explicit S21UpdatableInverse(
+      const S21Matrix &matrix,
+      int refactor_interval = kDefaultRefactorInterval);
+
+  const S21Matrix &getMatrix() const { return matrix_; }
+  const S21Matrix &getInverse() const { return inverse_; }
+  double getDeterminant() const { return determinant_; }
+  int getUpdatesSinceRefactor() const { return updates_; }
+
+  // A += U * V^T, U и V размера n x k. При вырожденном результате, в том
+  // числе при неудачном периодическом переразложении, бросает
+  // std::invalid_argument и оставляет состояние прежним.
+  void Update(const S21Matrix &u, const S21Matrix &v);
+  // замена строки row значениями values (1 x n), обновление ранга 1
+  void SetRow(int row, const S21Matrix &values);
+  void SetElement(int row, int col, double value);
+  // полный пересчёт обратной и определителя
+  void Refactor();
+
+ private:
+  // обратная и определитель matrix через LU, бросает для вырожденной
+  static void Invert(const S21Matrix &matrix, S21Matrix &inverse,
+                     double &determinant);
+
+  S21Matrix matrix_;
+  S21Matrix inverse_;
+  double determinant_;
+  int refactor_interval_;
+  int updates_;
+};
+
+#endif  // S21_INVERSE_UPDATE_H
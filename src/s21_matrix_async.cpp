@@ -0,0 +1,27 @@
+#include "s21_matrix_oop.h"
+
+// Асинхронные операции захватывают копии аргументов, поэтому исходные
+// матрицы можно менять или удалять, не дожидаясь результата
+
+S21Future<S21Matrix> S21Matrix::MultiplyAsync(const S21Matrix &other) const {
+  return S21Async([a = *this, b = other]() { return a.Multiply(b); });
+}
+
+S21Future<S21Matrix> S21Matrix::InverseAsync(S21Precision precision) const {
+  return S21Async(
+      [a = *this, precision]() { return a.InverseMatrix(precision); });
+}
+
+S21Future<S21Matrix> S21Matrix::SolveAsync(const S21Matrix &b,
+                                           S21Precision precision) const {
+  return S21Async(
+      [a = *this, b, precision]() { return a.Solve(b, precision); });
+}
+
+S21Future<S21Matrix> S21Matrix::CalcComplementsAsync() const {
+  return S21Async([a = *this]() { return a.CalcComplements(); });
+}
+
+S21Future<double> S21Matrix::DeterminantAsync() const {
+  return S21Async([a = *this]() { return a.Determinant(); });
+}
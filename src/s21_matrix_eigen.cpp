@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+namespace {
+// ширина панели блочной тридиагонализации (как nb в LAPACK dsytrd)
+const int kPanelWidth = 32;
+// строк на одну задачу пула в операциях уровня 2
+const int kRowGrain = 64;
+const int kMaxQlIterations = 60;
+
+// Рабочее представление: полная симметричная матрица n x n по строкам
+struct Tridiagonal {
+  int n = 0;
+  std::vector<double> a;
+  std::vector<double> diag, offdiag, tau;
+
+  double *Row(int i) { return a.data() + static_cast<size_t>(i) * n; }
+};
+
+// отражение Хаусхолдера H = I - tau * v * v^T, переводящее (alpha, x) в
+// (beta, 0); v[0] = 1, остальная часть v записывается на место x (dlarfg)
+double MakeReflector(double &alpha, double *x, int count, int stride) {
+  double norm = 0.0;
+  for (int k = 0; k < count; ++k) norm = std::hypot(norm, x[k * stride]);
+  if (norm == 0.0) return 0.0;
+  double beta = -std::copysign(std::hypot(alpha, norm), alpha);
+  double tau = (beta - alpha) / beta;
+  double scale = 1.0 / (alpha - beta);
+  for (int k = 0; k < count; ++k) x[k * stride] *= scale;
+  alpha = beta;
+  return tau;
+}
+
+// Панель dlatrd: приводит столбцы [k, k + nb) и строит W, так что
+// оставшаяся часть обновляется как A22 -= V * W^T + W * V^T
+void ReducePanel(Tridiagonal &t, int k, int nb, std::vector<double> &w) {
+  const int n = t.n;
+  auto v_at = [&t](int r, int j) { return t.Row(r)[j]; };
+  auto w_at = [&w, nb](int r, int j) -> double & {
+    return w[static_cast<size_t>(r) * nb + j];
+  };
+  std::vector<double> v(n), y(n), tmp(nb);
+  for (int i = 0; i < nb; ++i) {
+    const int c = k + i;
+    // столбец c с учётом предыдущих отражений панели
+    for (int r = c; r < n; ++r) {
+      double correction = 0.0;
+      for (int j = 0; j < i; ++j) {
+        correction += v_at(r, k + j) * w_at(c, j) + w_at(r, j) * v_at(c, k + j);
+      }
+      t.Row(r)[c] -= correction;
+    }
+    t.diag[c] = t.Row(c)[c];
+    if (c == n - 1) {
+      t.tau[c] = 0.0;
+      continue;
+    }
+    double alpha = t.Row(c + 1)[c];
+    t.tau[c] = MakeReflector(alpha, t.Row(std::min(c + 2, n - 1)) + c,
+                             n - c - 2, n);
+    t.offdiag[c] = alpha;
+    t.Row(c + 1)[c] = 1.0;
+    const int m = n - c - 1;
+    for (int r = 0; r < m; ++r) v[r] = t.Row(c + 1 + r)[c];
+    // y = A22 * v по матрице на начало панели
+    S21ParallelFor(0, m, kRowGrain, [&](int from, int to) {
+      for (int r = from; r < to; ++r) {
+        const double *row = t.Row(c + 1 + r) + c + 1;
+        double sum = 0.0;
+        for (int q = 0; q < m; ++q) sum += row[q] * v[q];
+        y[r] = sum;
+      }
+    });
+    // поправки от уже найденных отражений панели
+    for (int j = 0; j < i; ++j) {
+      double sw = 0.0, sv = 0.0;
+      for (int r = 0; r < m; ++r) {
+        sw += w_at(c + 1 + r, j) * v[r];
+        sv += v_at(c + 1 + r, k + j) * v[r];
+      }
+      tmp[j] = sw;
+      for (int r = 0; r < m; ++r) {
+        y[r] -= v_at(c + 1 + r, k + j) * sw + w_at(c + 1 + r, j) * sv;
+      }
+    }
+    double tau = t.tau[c];
+    double dot = 0.0;
+    for (int r = 0; r < m; ++r) {
+      y[r] *= tau;
+      dot += y[r] * v[r];
+    }
+    double shift = -0.5 * tau * dot;
+    for (int r = 0; r < m; ++r) w_at(c + 1 + r, i) = y[r] + shift * v[r];
+  }
+}
+
+void Tridiagonalize(Tridiagonal &t) {
+  const int n = t.n;
+  t.diag.assign(n, 0.0);
+  t.offdiag.assign(n, 0.0);
+  t.tau.assign(n, 0.0);
+  std::vector<double> w;
+  for (int k = 0; k < n; k += kPanelWidth) {
+    const int nb = std::min(kPanelWidth, n - k);
+    w.assign(static_cast<size_t>(n) * nb, 0.0);
+    ReducePanel(t, k, nb, w);
+    const int t0 = k + nb;
+    const int m = n - t0;
+    if (m > 0) {
+      // A22 -= V * W^T + W * V^T через блочное ядро
+      std::vector<double *> v_rows(m), w_rows(m), a_rows(m);
+      for (int r = 0; r < m; ++r) {
+        v_rows[r] = t.Row(t0 + r) + k;
+        w_rows[r] = &w[static_cast<size_t>(t0 + r) * nb];
+        a_rows[r] = t.Row(t0 + r) + t0;
+      }
+      S21GemmKernel(m, m, nb, -1.0, v_rows.data(), false, w_rows.data(),
+                    true, 1.0, a_rows.data());
+      S21GemmKernel(m, m, nb, -1.0, w_rows.data(), false, v_rows.data(),
+                    true, 1.0, a_rows.data());
+    }
+    for (int c = k; c < t0 && c < n - 1; ++c) t.Row(c + 1)[c] = t.offdiag[c];
+  }
+}
+
+// Q^T = H(n-2)...H(0): строки результата - столбцы Q
+std::vector<double> BuildQTransposed(Tridiagonal &t) {
+  const int n = t.n;
+  std::vector<double> q(static_cast<size_t>(n) * n, 0.0);
+  for (int i = 0; i < n; ++i) q[static_cast<size_t>(i) * n + i] = 1.0;
+  std::vector<double> v(n);
+  // Q = H(0) * ... * H(n-2) * I; Q^T получается применением H(j) справа
+  for (int j = n - 2; j >= 0; --j) {
+    const double tau = t.tau[j];
+    if (tau == 0.0) continue;
+    v[j + 1] = 1.0;
+    for (int r = j + 2; r < n; ++r) v[r] = t.Row(r)[j];
+    S21ParallelFor(0, n, kRowGrain, [&](int from, int to) {
+      for (int row = from; row < to; ++row) {
+        double *qt = &q[static_cast<size_t>(row) * n];
+        double dot = 0.0;
+        for (int r = j + 1; r < n; ++r) dot += qt[r] * v[r];
+        dot *= tau;
+        for (int r = j + 1; r < n; ++r) qt[r] -= dot * v[r];
+      }
+    });
+  }
+  return q;
+}
+
+// неявный QL-алгоритм со сдвигами Уилкинсона (tqli); вращения применяются
+// к строкам z, то есть к столбцам матрицы собственных векторов
+void ImplicitQl(std::vector<double> &d, std::vector<double> &e, double *z,
+                int n) {
+  for (int l = 0; l < n; ++l) {
+    int iter = 0;
+    int m;
+    do {
+      for (m = l; m < n - 1; ++m) {
+        double dd = std::fabs(d[m]) + std::fabs(d[m + 1]);
+        if (std::fabs(e[m]) <= DBL_EPSILON * dd) break;
+      }
+      if (m == l) break;
+      if (++iter > kMaxQlIterations) {
+        throw std::runtime_error("Eigenvalue iteration did not converge.");
+      }
+      double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+      double r = std::hypot(g, 1.0);
+      g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+      double s = 1.0, c = 1.0, p = 0.0;
+      int i;
+      for (i = m - 1; i >= l; --i) {
+        double f = s * e[i];
+        double b = c * e[i];
+        r = std::hypot(f, g);
+        e[i + 1] = r;
+        if (r == 0.0) {
+          d[i + 1] -= p;
+          e[m] = 0.0;
+          break;
+        }
+        s = f / r;
+        c = g / r;
+        g = d[i + 1] - p;
+        r = (d[i] - g) * s + 2.0 * c * b;
+        p = s * r;
+        d[i + 1] = g + p;
+        g = c * r - b;
+        if (z != nullptr) {
+          double *zi = z + static_cast<size_t>(i) * n;
+          double *zi1 = zi + n;
+          for (int k = 0; k < n; ++k) {
+            double zk = zi1[k];
+            zi1[k] = s * zi[k] + c * zk;
+            zi[k] = c * zi[k] - s * zk;
+          }
+        }
+      }
+      if (r == 0.0 && i >= l) continue;
+      d[l] -= p;
+      e[l] = g;
+      e[m] = 0.0;
+    } while (m != l);
+  }
+}
+
+Tridiagonal PrepareSymmetric(const S21Matrix &matrix) {
+  const int n = matrix.getRows();
+  if (n != matrix.getCols()) {
+    throw std::invalid_argument(
+        "Matrix must be square to calculate eigenvalues.");
+  }
+  double **src = matrix.getMatrix();
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < i; ++j) {
+      if (std::fabs(src[i][j] - src[j][i]) > 1e-7) {
+        throw std::invalid_argument("Matrix is not symmetric.");
+      }
+    }
+  }
+  Tridiagonal t;
+  t.n = n;
+  t.a.resize(static_cast<size_t>(n) * n);
+  for (int i = 0; i < n; ++i) std::copy(src[i], src[i] + n, t.Row(i));
+  Tridiagonalize(t);
+  return t;
+}
+}  // namespace
+
+// собственные значения симметричной матрицы по возрастанию
+std::vector<double> S21Matrix::EigenSymmetric() const {
+  Tridiagonal t = PrepareSymmetric(*this);
+  ImplicitQl(t.diag, t.offdiag, nullptr, t.n);
+  std::sort(t.diag.begin(), t.diag.end());
+  return t.diag;
+}
+
+// собственные векторы записываются в столбцы vectors
+std::vector<double> S21Matrix::EigenSymmetric(S21Matrix &vectors) const {
+  Tridiagonal t = PrepareSymmetric(*this);
+  const int n = t.n;
+  std::vector<double> zt = BuildQTransposed(t);
+  ImplicitQl(t.diag, t.offdiag, zt.data(), n);
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&t](int x, int y) { return t.diag[x] < t.diag[y]; });
+  S21Matrix result(n, n);
+  std::vector<double> values(n);
+  for (int col = 0; col < n; ++col) {
+    values[col] = t.diag[order[col]];
+    const double *zrow = &zt[static_cast<size_t>(order[col]) * n];
+    for (int row = 0; row < n; ++row) result.matrix_[row][col] = zrow[row];
+  }
+  vectors = std::move(result);
+  return values;
+}
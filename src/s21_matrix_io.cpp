@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+namespace {
+// файл читается блоками по 16 МиБ, неполная последняя строка переносится
+// в следующий блок
+const size_t kChunkSize = size_t(16) << 20;
+// меньшие блоки разбираются в одном потоке
+const size_t kParallelChunk = size_t(1) << 20;
+// строк в одной порции записи
+const int kWriteBatchRows = 4096;
+
+struct FileCloser {
+  void operator()(FILE *file) const { std::fclose(file); }
+};
+using FileHandle = std::unique_ptr<FILE, FileCloser>;
+
+FileHandle OpenFile(const std::string &path, const char *mode) {
+  FileHandle file(std::fopen(path.c_str(), mode));
+  if (!file) throw std::runtime_error("Cannot open file: " + path);
+  return file;
+}
+
+class ChunkReader {
+ public:
+  explicit ChunkReader(FILE *file) : file_(file), buffer_(kChunkSize) {}
+
+  // следующий участок из целых строк, false в конце файла
+  bool Next(const char *&begin, const char *&end) {
+    if (eof_ && carry_ == 0) return false;
+    if (consumed_ > 0) {
+      std::memmove(buffer_.data(), buffer_.data() + consumed_, carry_);
+      consumed_ = 0;
+    }
+    size_t filled = carry_;
+    size_t last_newline = 0;
+    bool found = false;
+    while (!eof_) {
+      if (filled == buffer_.size()) buffer_.resize(buffer_.size() * 2);
+      size_t got = std::fread(buffer_.data() + filled, 1,
+                              buffer_.size() - filled, file_);
+      if (got == 0) {
+        if (std::ferror(file_)) throw std::runtime_error("Read error.");
+        eof_ = true;
+        break;
+      }
+      size_t search_from = filled;
+      filled += got;
+      for (size_t k = filled; k > search_from; --k) {
+        if (buffer_[k - 1] == '\n') {
+          last_newline = k;
+          found = true;
+          break;
+        }
+      }
+      if (found) break;
+    }
+    size_t length = eof_ ? filled : last_newline;
+    begin = buffer_.data();
+    end = begin + length;
+    consumed_ = length;
+    carry_ = filled - length;
+    return length > 0;
+  }
+
+ private:
+  FILE *file_;
+  std::vector<char> buffer_;
+  size_t carry_ = 0;
+  size_t consumed_ = 0;
+  bool eof_ = false;
+};
+
+bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char *ParseNumber(const char *p, const char *end, double &value) {
+  if (p < end && *p == '+') ++p;
+  auto result = std::from_chars(p, end, value);
+  if (result.ec == std::errc::invalid_argument) {
+    throw std::invalid_argument("Malformed number in matrix text.");
+  }
+  if (result.ec == std::errc::result_out_of_range) {
+    throw std::invalid_argument("Number in matrix text is out of range.");
+  }
+  return result.ptr;
+}
+
+// результат разбора куска: значения подряд, число строк и длина строки
+struct ParsedPart {
+  std::vector<double> values;
+  long long rows = 0;
+  long long row_length = -1;
+};
+
+// разбор строк CSV или разделённых пробелами
+void ParseRows(const char *p, const char *end, char separator,
+               ParsedPart &part) {
+  while (p < end) {
+    long long count = 0;
+    for (;;) {
+      while (p < end && IsBlank(*p)) ++p;
+      if (p == end || *p == '\n') break;
+      if (count > 0 && separator != ' ') {
+        if (*p != separator) {
+          throw std::invalid_argument("Expected a separator in matrix text.");
+        }
+        ++p;
+        while (p < end && IsBlank(*p)) ++p;
+      }
+      double value;
+      p = ParseNumber(p, end, value);
+      part.values.push_back(value);
+      ++count;
+      if (p < end && !IsBlank(*p) && *p != '\n' && *p != separator) {
+        throw std::invalid_argument("Malformed number in matrix text.");
+      }
+    }
+    if (p < end) ++p;
+    if (count == 0) continue;
+    if (part.row_length >= 0 && part.row_length != count) {
+      throw std::invalid_argument("Rows of matrix text differ in length.");
+    }
+    part.row_length = count;
+    ++part.rows;
+  }
+}
+
+// разбор потока чисел без учёта строк (тело MatrixMarket)
+void ParseFlat(const char *p, const char *end, ParsedPart &part) {
+  while (p < end) {
+    while (p < end && (IsBlank(*p) || *p == '\n')) ++p;
+    if (p == end) break;
+    if (*p == '%') {
+      while (p < end && *p != '\n') ++p;
+      continue;
+    }
+    double value;
+    p = ParseNumber(p, end, value);
+    part.values.push_back(value);
+    if (p < end && !IsBlank(*p) && *p != '\n') {
+      throw std::invalid_argument("Malformed number in matrix text.");
+    }
+  }
+}
+
+// делит участок по границам строк и разбирает части параллельно,
+// результат дописывается в total в исходном порядке
+void ParseChunk(const char *begin, const char *end, bool parallel, bool flat,
+                char separator, ParsedPart &total) {
+  int parts = 1;
+  if (parallel && static_cast<size_t>(end - begin) >= kParallelChunk) {
+    parts = S21GetThreadCount();
+  }
+  std::vector<const char *> bounds(parts + 1, end);
+  bounds[0] = begin;
+  for (int k = 1; k < parts; ++k) {
+    const char *p = std::max(bounds[k - 1], begin + (end - begin) * k / parts);
+    while (p > begin && p < end && p[-1] != '\n') ++p;
+    bounds[k] = p;
+  }
+  std::vector<ParsedPart> parsed(parts);
+  S21ParallelFor(0, parts, 1, [&](int from, int to) {
+    for (int k = from; k < to; ++k) {
+      if (flat) {
+        ParseFlat(bounds[k], bounds[k + 1], parsed[k]);
+      } else {
+        ParseRows(bounds[k], bounds[k + 1], separator, parsed[k]);
+      }
+    }
+  });
+  for (ParsedPart &part : parsed) {
+    if (part.rows > 0) {
+      if (total.row_length >= 0 && total.row_length != part.row_length) {
+        throw std::invalid_argument("Rows of matrix text differ in length.");
+      }
+      total.row_length = part.row_length;
+      total.rows += part.rows;
+    }
+    total.values.insert(total.values.end(), part.values.begin(),
+                        part.values.end());
+  }
+}
+
+std::string NextLine(const char *&p, const char *end) {
+  const char *start = p;
+  while (p < end && *p != '\n') ++p;
+  std::string line(start, p);
+  if (p < end) ++p;
+  if (!line.empty() && line.back() == '\r') line.pop_back();
+  return line;
+}
+
+S21Matrix MakeMatrix(long long rows, long long cols,
+                     const std::vector<double> &values) {
+  if (rows <= 0 || cols <= 0 || rows > INT32_MAX || cols > INT32_MAX) {
+    throw std::invalid_argument("Matrix text has invalid dimensions.");
+  }
+  S21Matrix result(static_cast<int>(rows), static_cast<int>(cols));
+  if (!values.empty()) {
+    std::memcpy(result.getMatrix()[0], values.data(),
+                sizeof(double) * values.size());
+  }
+  return result;
+}
+
+// MatrixMarket: array хранится по столбцам, coordinate - тройками i j v
+S21Matrix LoadMatrixMarket(ChunkReader &reader, const char *p,
+                           const char *end, bool parallel) {
+  std::string header = NextLine(p, end);
+  char object[32] = {0}, layout[32] = {0}, field[32] = {0}, symmetry[32] = {0};
+  if (std::sscanf(header.c_str(), "%%%%MatrixMarket %31s %31s %31s %31s",
+                  object, layout, field, symmetry) != 4 ||
+      std::strcmp(object, "matrix") != 0) {
+    throw std::invalid_argument("Unsupported MatrixMarket header.");
+  }
+  bool coordinate = std::strcmp(layout, "coordinate") == 0;
+  bool pattern = std::strcmp(field, "pattern") == 0;
+  bool symmetric = std::strcmp(symmetry, "symmetric") == 0;
+  bool skew = std::strcmp(symmetry, "skew-symmetric") == 0;
+  if ((!coordinate && std::strcmp(layout, "array") != 0) ||
+      std::strcmp(field, "complex") == 0 || (pattern && !coordinate) ||
+      (!symmetric && !skew && std::strcmp(symmetry, "general") != 0)) {
+    throw std::invalid_argument("Unsupported MatrixMarket header.");
+  }
+  std::string size_line;
+  do {
+    if (p == end) throw std::invalid_argument("MatrixMarket size is missing.");
+    size_line = NextLine(p, end);
+  } while (size_line.empty() || size_line[0] == '%');
+  long long rows = 0, cols = 0, entries = 0;
+  int fields = std::sscanf(size_line.c_str(), "%lld %lld %lld", &rows, &cols,
+                           &entries);
+  if (fields < (coordinate ? 3 : 2)) {
+    throw std::invalid_argument("Malformed MatrixMarket size line.");
+  }
+  ParsedPart body;
+  ParseChunk(p, end, parallel, true, ' ', body);
+  while (reader.Next(p, end)) ParseChunk(p, end, parallel, true, ' ', body);
+
+  S21Matrix result = MakeMatrix(rows, cols, {});
+  double **m = result.getMatrix();
+  auto put = [&](long long i, long long j, double value) {
+    if (i < 0 || j < 0 || i >= rows || j >= cols) {
+      throw std::invalid_argument("MatrixMarket entry is out of range.");
+    }
+    m[i][j] = value;
+    if ((symmetric || skew) && i != j) {
+      if (j >= rows || i >= cols) {
+        throw std::invalid_argument("MatrixMarket entry is out of range.");
+      }
+      m[j][i] = skew ? -value : value;
+    }
+  };
+  const std::vector<double> &v = body.values;
+  if (coordinate) {
+    size_t stride = pattern ? 2 : 3;
+    if (v.size() != static_cast<size_t>(entries) * stride) {
+      throw std::invalid_argument("MatrixMarket entry count mismatch.");
+    }
+    for (size_t k = 0; k < v.size(); k += stride) {
+      long long i = static_cast<long long>(v[k]) - 1;
+      long long j = static_cast<long long>(v[k + 1]) - 1;
+      put(i, j, pattern ? 1.0 : v[k + 2]);
+    }
+  } else {
+    size_t k = 0;
+    for (long long j = 0; j < cols; ++j) {
+      long long first = symmetric ? j : (skew ? j + 1 : 0);
+      for (long long i = first; i < rows; ++i) {
+        if (k == v.size()) {
+          throw std::invalid_argument("MatrixMarket entry count mismatch.");
+        }
+        put(i, j, v[k++]);
+      }
+    }
+    if (k != v.size()) {
+      throw std::invalid_argument("MatrixMarket entry count mismatch.");
+    }
+  }
+  return result;
+}
+
+class ChunkWriter {
+ public:
+  explicit ChunkWriter(FILE *file) : file_(file) {}
+  void Write(const char *data, size_t size) {
+    if (size > 0 && std::fwrite(data, 1, size, file_) != size) {
+      throw std::runtime_error("Write error.");
+    }
+  }
+  void Write(const std::string &text) { Write(text.data(), text.size()); }
+
+ private:
+  FILE *file_;
+};
+
+// кратчайшее представление, которое читается обратно без потерь
+void AppendNumber(std::string &out, double value) {
+  char buffer[32];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
+}
+}  // namespace
+
+S21Matrix S21Matrix::LoadText(const std::string &path, S21TextFormat format,
+                              bool parallel) {
+  FileHandle file = OpenFile(path, "rb");
+  ChunkReader reader(file.get());
+  const char *begin = nullptr;
+  const char *end = nullptr;
+  if (!reader.Next(begin, end)) {
+    throw std::invalid_argument("Matrix text is empty.");
+  }
+  const char *first = begin;
+  while (first < end && (IsBlank(*first) || *first == '\n')) ++first;
+  if (format == S21TextFormat::kAuto) {
+    if (end - first >= 14 && std::memcmp(first, "%%MatrixMarket", 14) == 0) {
+      format = S21TextFormat::kMatrixMarket;
+    } else {
+      const char *line_end = first;
+      while (line_end < end && *line_end != '\n') ++line_end;
+      format = std::find(first, line_end, ',') != line_end
+                   ? S21TextFormat::kCsv
+                   : S21TextFormat::kWhitespace;
+    }
+  }
+  if (format == S21TextFormat::kMatrixMarket) {
+    return LoadMatrixMarket(reader, first, end, parallel);
+  }
+  char separator = format == S21TextFormat::kCsv ? ',' : ' ';
+  ParsedPart total;
+  do {
+    ParseChunk(begin, end, parallel, false, separator, total);
+  } while (reader.Next(begin, end));
+  return MakeMatrix(total.rows, total.row_length, total.values);
+}
+
+void S21Matrix::SaveText(const std::string &path, S21TextFormat format) const {
+  if (matrix_ == nullptr) {
+    throw std::invalid_argument("Matrix is empty and cannot be saved.");
+  }
+  FileHandle file = OpenFile(path, "wb");
+  ChunkWriter writer(file.get());
+  bool market = format == S21TextFormat::kMatrixMarket;
+  // MatrixMarket array пишется по столбцам: порция - это столбцы
+  int lines = market ? cols_ : rows_;
+  int length = market ? rows_ : cols_;
+  char separator = format == S21TextFormat::kCsv ? ',' : ' ';
+  if (market) {
+    writer.Write("%%MatrixMarket matrix array real general\n" +
+                 std::to_string(rows_) + " " + std::to_string(cols_) + "\n");
+  }
+  for (int batch = 0; batch < lines; batch += kWriteBatchRows) {
+    int batch_end = std::min(lines, batch + kWriteBatchRows);
+    int parts = std::min(S21GetThreadCount(), batch_end - batch);
+    std::vector<std::string> text(parts);
+    S21ParallelFor(0, parts, 1, [&](int from, int to) {
+      for (int part = from; part < to; ++part) {
+        int first = batch + (batch_end - batch) * part / parts;
+        int last = batch + (batch_end - batch) * (part + 1) / parts;
+        std::string &out = text[part];
+        for (int line = first; line < last; ++line) {
+          for (int k = 0; k < length; ++k) {
+            if (market) {
+              AppendNumber(out, matrix_[k][line]);
+              out.push_back('\n');
+            } else {
+              if (k > 0) out.push_back(separator);
+              AppendNumber(out, matrix_[line][k]);
+            }
+          }
+          if (!market) out.push_back('\n');
+        }
+      }
+    });
+    for (const std::string &out : text) writer.Write(out);
+  }
+  if (std::fflush(file.get()) != 0) throw std::runtime_error("Write error.");
+}
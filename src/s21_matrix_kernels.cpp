@@ -0,0 +1,231 @@
+#include "s21_matrix_kernels.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "s21_numa.h"
+#include "s21_parallel.h"
+
+namespace {
+// размеры блоков подобраны так, чтобы упакованный блок A помещался в L1,
+// а панель B - в L2
+const int kBlockM = 64;
+const int kBlockK = 256;
+const int kBlockN = 512;
+// меньшие задачи выполняются в одном потоке
+const long long kParallelThreshold = 64LL * 64 * 64;
+// Syrk делит k на куски, если у C меньше kSyrkSplitRows строк
+const int kSyrkSplitRows = 256;
+const int kSyrkSplitK = 4096;
+const int kMaxSyrkSplits = 16;
+
+template <typename T>
+void ScaleRows(int row_begin, int row_end, int n, T beta, T *const *c) {
+  if (beta == T(1)) return;
+  for (int i = row_begin; i < row_end; ++i) {
+    T *row = c[i];
+    if (beta == T(0)) {
+      std::fill(row, row + n, T(0));
+    } else {
+      for (int j = 0; j < n; ++j) row[j] *= beta;
+    }
+  }
+}
+
+// Буферы упаковки потока растут до самой большой задачи и остаются, так что
+// повторные умножения не выделяют память. Ядра внутри не ждут задач пула,
+// поэтому буфер не может понадобиться вложенному вызову в том же потоке.
+template <typename T>
+T *PackBuffer(int slot, size_t size) {
+  thread_local std::vector<T> buffers[2];
+  if (buffers[slot].size() < size) buffers[slot].resize(size);
+  return buffers[slot].data();
+}
+
+template <typename T>
+void GemmRows(int row_begin, int row_end, int n, int k, T alpha, T *const *a,
+              bool trans_a, T *const *b, bool trans_b, T *const *c) {
+  // буферы не больше самой задачи: для маленьких матриц обнуление полных
+  // блоков стоило дороже умножения
+  const int k_block = std::min(kBlockK, k);
+  T *a_pack =
+      PackBuffer<T>(0, std::min(kBlockM, row_end - row_begin) * k_block);
+  T *b_pack = PackBuffer<T>(1, k_block * std::min(kBlockN, n));
+  for (int jc = 0; jc < n; jc += kBlockN) {
+    int nc = std::min(kBlockN, n - jc);
+    for (int pc = 0; pc < k; pc += kBlockK) {
+      int kc = std::min(kBlockK, k - pc);
+      // панель op(B) размером kc x nc
+      for (int p = 0; p < kc; ++p) {
+        T *dst = &b_pack[p * nc];
+        if (trans_b) {
+          for (int j = 0; j < nc; ++j) dst[j] = b[jc + j][pc + p];
+        } else {
+          const T *src = b[pc + p] + jc;
+          std::copy(src, src + nc, dst);
+        }
+      }
+      for (int ic = row_begin; ic < row_end; ic += kBlockM) {
+        int mc = std::min(kBlockM, row_end - ic);
+        // блок alpha * op(A) размером mc x kc
+        for (int i = 0; i < mc; ++i) {
+          T *dst = &a_pack[i * kc];
+          if (trans_a) {
+            for (int p = 0; p < kc; ++p) dst[p] = alpha * a[pc + p][ic + i];
+          } else {
+            const T *src = a[ic + i] + pc;
+            for (int p = 0; p < kc; ++p) dst[p] = alpha * src[p];
+          }
+        }
+        for (int i = 0; i < mc; ++i) {
+          T *c_row = c[ic + i] + jc;
+          const T *a_row = &a_pack[i * kc];
+          for (int p = 0; p < kc; ++p) {
+            const T a_ip = a_row[p];
+            const T *b_row = &b_pack[p * nc];
+            for (int j = 0; j < nc; ++j) c_row[j] += a_ip * b_row[j];
+          }
+        }
+      }
+    }
+  }
+}
+
+// Нижний треугольник строк [row_begin, row_end) C по столбцам op(A)
+// [k_begin, k_end). Как GemmRows, но блоки B берутся из той же op(A), а в
+// строке i обновляются только столбцы j <= i.
+void SyrkRows(int row_begin, int row_end, int k_begin, int k_end,
+              double alpha, double *const *a, bool trans, double *const *c) {
+  const int k = k_end - k_begin;
+  const int k_block = std::min(kBlockK, k);
+  double *a_pack = PackBuffer<double>(
+      0, std::min(kBlockM, row_end - row_begin) * k_block);
+  double *b_pack = PackBuffer<double>(1, k_block * std::min(kBlockN, row_end));
+  // op(A)[i][p]
+  auto element = [a, trans](int i, int p) { return trans ? a[p][i] : a[i][p]; };
+  for (int jc = 0; jc < row_end; jc += kBlockN) {
+    int nc = std::min(kBlockN, row_end - jc);
+    for (int pc = k_begin; pc < k_end; pc += kBlockK) {
+      int kc = std::min(kBlockK, k_end - pc);
+      // панель op(A)^T размером kc x nc
+      for (int p = 0; p < kc; ++p) {
+        double *dst = &b_pack[p * nc];
+        if (trans) {
+          const double *src = a[pc + p] + jc;
+          std::copy(src, src + nc, dst);
+        } else {
+          for (int j = 0; j < nc; ++j) dst[j] = a[jc + j][pc + p];
+        }
+      }
+      // строки выше jc не пересекают этот столбцовый блок
+      for (int ic = std::max(row_begin, jc); ic < row_end; ic += kBlockM) {
+        int mc = std::min(kBlockM, row_end - ic);
+        for (int i = 0; i < mc; ++i) {
+          double *dst = &a_pack[i * kc];
+          for (int p = 0; p < kc; ++p) dst[p] = alpha * element(ic + i, pc + p);
+        }
+        for (int i = 0; i < mc; ++i) {
+          double *c_row = c[ic + i] + jc;
+          const int width = std::min(nc, ic + i - jc + 1);
+          const double *a_row = &a_pack[i * kc];
+          for (int p = 0; p < kc; ++p) {
+            const double a_ip = a_row[p];
+            const double *b_row = &b_pack[p * nc];
+            for (int j = 0; j < width; ++j) c_row[j] += a_ip * b_row[j];
+          }
+        }
+      }
+    }
+  }
+}
+
+void ScaleLower(int row_begin, int row_end, double beta, double *const *c) {
+  if (beta == 1.0) return;
+  for (int i = row_begin; i < row_end; ++i) {
+    double *row = c[i];
+    if (beta == 0.0) {
+      std::fill(row, row + i + 1, 0.0);
+    } else {
+      for (int j = 0; j <= i; ++j) row[j] *= beta;
+    }
+  }
+}
+
+template <typename T>
+void GemmKernel(int m, int n, int k, T alpha, T *const *a, bool trans_a,
+                T *const *b, bool trans_b, T beta, T *const *c) {
+  auto body = [=](int row_begin, int row_end) {
+    ScaleRows(row_begin, row_end, n, beta, c);
+    if (alpha != T(0) && k > 0) {
+      GemmRows(row_begin, row_end, n, k, alpha, a, trans_a, b, trans_b, c);
+    }
+  };
+  if (static_cast<long long>(m) * n * k < kParallelThreshold) {
+    body(0, m);
+  } else if (S21NumaNodeCount() > 1 &&
+             S21GetNumaPolicy() == S21NumaPolicy::kFirstTouch) {
+    // строки C обрабатывают те же потоки, что заполняли буфер при выделении
+    S21ParallelForStatic(0, m, body);
+  } else {
+    S21ParallelFor(0, m, kBlockM, body);
+  }
+}
+
+}  // namespace
+
+void S21GemmKernel(int m, int n, int k, double alpha, double *const *a,
+                   bool trans_a, double *const *b, bool trans_b, double beta,
+                   double *const *c) {
+  GemmKernel(m, n, k, alpha, a, trans_a, b, trans_b, beta, c);
+}
+
+void S21GemmKernel(int m, int n, int k, float alpha, float *const *a,
+                   bool trans_a, float *const *b, bool trans_b, float beta,
+                   float *const *c) {
+  GemmKernel(m, n, k, alpha, a, trans_a, b, trans_b, beta, c);
+}
+
+// Для узких высоких A (мало строк C, длинное k) строк C не хватает на все
+// потоки, поэтому k делится на куски с собственными треугольниками,
+// которые затем складываются. Число кусков зависит только от k, так что
+// результат не зависит от числа потоков.
+void S21SyrkKernel(int n, int k, double alpha, double *const *a, bool trans,
+                   double beta, double *const *c) {
+  S21ParallelFor(0, n, kBlockM,
+                 [=](int from, int to) { ScaleLower(from, to, beta, c); });
+  if (alpha != 0.0 && k > 0) {
+    const long long work = static_cast<long long>(n) * n * k / 2;
+    const int splits = std::min(kMaxSyrkSplits, k / kSyrkSplitK);
+    if (work < kParallelThreshold) {
+      SyrkRows(0, n, 0, k, alpha, a, trans, c);
+    } else if (n < kSyrkSplitRows && splits > 1) {
+      std::vector<std::vector<double>> partial(
+          splits, std::vector<double>(static_cast<size_t>(n) * n));
+      S21ParallelFor(0, splits, 1, [&](int from, int to) {
+        std::vector<double *> rows(n);
+        for (int s = from; s < to; ++s) {
+          for (int i = 0; i < n; ++i) rows[i] = &partial[s][i * n];
+          SyrkRows(0, n, static_cast<int>(1LL * k * s / splits),
+                   static_cast<int>(1LL * k * (s + 1) / splits), alpha,
+                   a, trans, rows.data());
+        }
+      });
+      for (int i = 0; i < n; ++i) {
+        for (int s = 0; s < splits; ++s) {
+          const double *row = &partial[s][i * n];
+          for (int j = 0; j <= i; ++j) c[i][j] += row[j];
+        }
+      }
+    } else {
+      // строки внизу треугольника длиннее, мелкие куски выравнивают нагрузку
+      S21ParallelFor(0, n, kBlockM, [=](int from, int to) {
+        SyrkRows(from, to, 0, k, alpha, a, trans, c);
+      });
+    }
+  }
+  S21ParallelFor(0, n, kBlockM, [=](int from, int to) {
+    for (int j = from; j < to; ++j) {
+      for (int i = j + 1; i < n; ++i) c[j][i] = c[i][j];
+    }
+  });
+}
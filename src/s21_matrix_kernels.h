@@ -0,0 +1,23 @@
+#ifndef S21_MATRIX_KERNELS_H
+#define S21_MATRIX_KERNELS_H
+
+// Блочное многопоточное ядро C = alpha * op(A) * op(B) + beta * C.
+// op(A) имеет размер m x k, op(B) - k x n, C - m x n. Матрицы передаются
+// массивами указателей на строки, транспонирование учитывается порядком
+// обхода при упаковке блоков. C не должна пересекаться с A и B.
+void S21GemmKernel(int m, int n, int k, double alpha, double *const *a,
+                   bool trans_a, double *const *b, bool trans_b, double beta,
+                   double *const *c);
+// float-вариант для разложения смешанной точности
+void S21GemmKernel(int m, int n, int k, float alpha, float *const *a,
+                   bool trans_a, float *const *b, bool trans_b, float beta,
+                   float *const *c);
+
+// Симметричное обновление ранга k: C = alpha * op(A) * op(A)^T + beta * C,
+// op(A) = A (n x k) или A^T при trans. Считается и масштабируется только
+// нижний треугольник C, затем он отражается в верхний. C не должна
+// пересекаться с A.
+void S21SyrkKernel(int n, int k, double alpha, double *const *a, bool trans,
+                   double beta, double *const *c);
+
+#endif  // S21_MATRIX_KERNELS_H
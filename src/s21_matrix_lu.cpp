@@ -0,0 +1,213 @@
+#include "s21_matrix_lu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_kernels.h"
+#include "s21_parallel.h"
+
+namespace {
+// ширина панели: обновление хвоста - умножение с внутренним размером
+// kLUBlock, панель факторизуется без умножений
+const int kLUBlock = 128;
+// панели не шире раскладываются по столбцам
+const int kPanelLeaf = 16;
+// ширина куска столбцов при треугольном решении в потоках
+const int kColumnGrain = 256;
+// при меньшем числе правых частей блочное решение не окупается
+const int kBlockedSolveColumns = 16;
+
+// указатели на строки [row_begin, row_end) начиная со столбца col
+template <typename T>
+std::vector<T *> Rows(T *a, int stride, int row_begin, int row_end, int col) {
+  std::vector<T *> rows(row_end - row_begin);
+  for (int i = row_begin; i < row_end; ++i) {
+    rows[i - row_begin] = a + static_cast<size_t>(i) * stride + col;
+  }
+  return rows;
+}
+
+// Столбцы [k0, k0 + kb) строк [k0, n) без блоков. Перестановки
+// применяются к строкам целиком, как в S21LUDecompose.
+template <typename T>
+bool FactorColumns(S21LUFactor<T> &factor, int k0, int kb) {
+  const int n = factor.n;
+  T *a = factor.lu.data();
+  for (int k = k0; k < k0 + kb; ++k) {
+    int pivot = k;
+    T best = std::fabs(a[static_cast<size_t>(k) * n + k]);
+    for (int i = k + 1; i < n; ++i) {
+      T value = std::fabs(a[static_cast<size_t>(i) * n + k]);
+      if (value > best) {
+        best = value;
+        pivot = i;
+      }
+    }
+    factor.pivots[k] = pivot;
+    if (best == 0.0 || !std::isfinite(best)) {
+      factor.singular = true;
+      factor.nonfinite = !std::isfinite(best);
+      return false;
+    }
+    if (pivot != k) {
+      std::swap_ranges(a + static_cast<size_t>(k) * n,
+                       a + static_cast<size_t>(k + 1) * n,
+                       a + static_cast<size_t>(pivot) * n);
+      factor.sign = -factor.sign;
+    }
+    const T *row_k = a + static_cast<size_t>(k) * n;
+    const int panel_end = k0 + kb;
+    for (int i = k + 1; i < n; ++i) {
+      T *row_i = a + static_cast<size_t>(i) * n;
+      T l = row_i[k] / row_k[k];
+      row_i[k] = l;
+      for (int j = k + 1; j < panel_end; ++j) row_i[j] -= l * row_k[j];
+    }
+  }
+  return true;
+}
+
+// X = L11^-1 * X для строк [k0, k0 + kb) и столбцов [col_begin, col_end),
+// L11 - единичная нижнетреугольная часть lu; x хранится с шагом stride
+template <typename T>
+void SolveUnitLower(const T *lu, int n, int k0, int kb, T *x,
+                    int stride, int col_begin, int col_end) {
+  S21ParallelFor(col_begin, col_end, kColumnGrain, [=](int from, int to) {
+    for (int i = k0 + 1; i < k0 + kb; ++i) {
+      T *row_i = x + static_cast<size_t>(i) * stride;
+      for (int p = k0; p < i; ++p) {
+        const T l = lu[static_cast<size_t>(i) * n + p];
+        const T *row_p = x + static_cast<size_t>(p) * stride;
+        for (int j = from; j < to; ++j) row_i[j] -= l * row_p[j];
+      }
+    }
+  });
+}
+
+// X = U11^-1 * X для строк [k0, k0 + kb), U11 с диагональю
+template <typename T>
+void SolveUpper(const T *lu, int n, int k0, int kb, T *x,
+                int stride, int col_begin, int col_end) {
+  S21ParallelFor(col_begin, col_end, kColumnGrain, [=](int from, int to) {
+    for (int i = k0 + kb - 1; i >= k0; --i) {
+      T *row_i = x + static_cast<size_t>(i) * stride;
+      for (int p = i + 1; p < k0 + kb; ++p) {
+        const T u = lu[static_cast<size_t>(i) * n + p];
+        const T *row_p = x + static_cast<size_t>(p) * stride;
+        for (int j = from; j < to; ++j) row_i[j] -= u * row_p[j];
+      }
+      const T diag = lu[static_cast<size_t>(i) * n + i];
+      for (int j = from; j < to; ++j) row_i[j] /= diag;
+    }
+  });
+}
+
+// Панель раскладывается рекурсивно: левая половина, затем правая половина
+// обновляется умножением. Иначе каждый столбец высокой панели заново
+// читал бы её из памяти целиком.
+template <typename T>
+bool FactorPanel(S21LUFactor<T> &factor, int k0, int kb) {
+  if (kb <= kPanelLeaf) return FactorColumns(factor, k0, kb);
+  const int n = factor.n;
+  T *a = factor.lu.data();
+  const int left = kb / 2;
+  const int mid = k0 + left;
+  const int end = k0 + kb;
+  if (!FactorPanel(factor, k0, left)) return false;
+  SolveUnitLower(a, n, k0, left, a, n, mid, end);
+  std::vector<T *> l21 = Rows(a, n, mid, n, k0);
+  std::vector<T *> u12 = Rows(a, n, k0, mid, mid);
+  std::vector<T *> a22 = Rows(a, n, mid, n, mid);
+  S21GemmKernel(n - mid, end - mid, left, T(-1), l21.data(), false, u12.data(),
+                false, T(1), a22.data());
+  return FactorPanel(factor, mid, kb - left);
+}
+
+// Правостороннее блочное разложение: панель, строки U12 = L11^-1 * A12,
+// затем A22 -= L21 * U12 через многопоточное ядро умножения
+template <typename T>
+bool DecomposeBlocked(S21LUFactor<T> &factor) {
+  const int n = factor.n;
+  if (n <= 2 * kLUBlock) return S21LUDecompose(factor);
+  T *a = factor.lu.data();
+  factor.pivots.assign(n, 0);
+  factor.sign = 1;
+  factor.singular = false;
+  factor.nonfinite = false;
+  for (int k0 = 0; k0 < n; k0 += kLUBlock) {
+    const int kb = std::min(kLUBlock, n - k0);
+    if (!FactorPanel(factor, k0, kb)) return false;
+    const int rest = k0 + kb;
+    if (rest == n) break;
+    SolveUnitLower(a, n, k0, kb, a, n, rest, n);
+    std::vector<T *> l21 = Rows(a, n, rest, n, k0);
+    std::vector<T *> u12 = Rows(a, n, k0, rest, rest);
+    std::vector<T *> a22 = Rows(a, n, rest, n, rest);
+    S21GemmKernel(n - rest, n - rest, kb, T(-1), l21.data(), false, u12.data(),
+                  false, T(1), a22.data());
+  }
+  return true;
+}
+
+// Блочные прямой и обратный ходы: решение внутри блока строк, затем
+// остальные строки обновляются умножением
+template <typename T>
+void SolveBlocked(const S21LUFactor<T> &factor, T *x, int m) {
+  const int n = factor.n;
+  if (n <= 2 * kLUBlock || m < kBlockedSolveColumns) {
+    S21LUSolve(factor, x, m);
+    return;
+  }
+  const T *lu = factor.lu.data();
+  // ядро умножения принимает неконстантные строки, lu оно только читает
+  T *const a = const_cast<T *>(lu);
+  for (int k = 0; k < n; ++k) {
+    int p = factor.pivots[k];
+    if (p != k) {
+      std::swap_ranges(x + static_cast<size_t>(k) * m,
+                       x + static_cast<size_t>(k + 1) * m,
+                       x + static_cast<size_t>(p) * m);
+    }
+  }
+  for (int k0 = 0; k0 < n; k0 += kLUBlock) {
+    const int kb = std::min(kLUBlock, n - k0);
+    const int rest = k0 + kb;
+    SolveUnitLower(lu, n, k0, kb, x, m, 0, m);
+    if (rest == n) break;
+    std::vector<T *> l21 = Rows(a, n, rest, n, k0);
+    std::vector<T *> x1 = Rows(x, m, k0, rest, 0);
+    std::vector<T *> x2 = Rows(x, m, rest, n, 0);
+    S21GemmKernel(n - rest, m, kb, T(-1), l21.data(), false, x1.data(), false,
+                  T(1), x2.data());
+  }
+  const int last = (n - 1) / kLUBlock * kLUBlock;
+  for (int k0 = last; k0 >= 0; k0 -= kLUBlock) {
+    const int kb = std::min(kLUBlock, n - k0);
+    SolveUpper(lu, n, k0, kb, x, m, 0, m);
+    if (k0 == 0) break;
+    std::vector<T *> u01 = Rows(a, n, 0, k0, k0);
+    std::vector<T *> x1 = Rows(x, m, k0, k0 + kb, 0);
+    std::vector<T *> x0 = Rows(x, m, 0, k0, 0);
+    S21GemmKernel(k0, m, kb, T(-1), u01.data(), false, x1.data(), false, T(1),
+                  x0.data());
+  }
+}
+}  // namespace
+
+bool S21LUDecomposeBlocked(S21LUFactor<double> &factor) {
+  return DecomposeBlocked(factor);
+}
+
+bool S21LUDecomposeBlocked(S21LUFactor<float> &factor) {
+  return DecomposeBlocked(factor);
+}
+
+void S21LUSolveBlocked(const S21LUFactor<double> &factor, double *x, int m) {
+  SolveBlocked(factor, x, m);
+}
+
+void S21LUSolveBlocked(const S21LUFactor<float> &factor, float *x, int m) {
+  SolveBlocked(factor, x, m);
+}
@@ -0,0 +1,171 @@
+#ifndef S21_MATRIX_LU_H
+#define S21_MATRIX_LU_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Выравнивание буферов разложения по строке кеша: блочное разложение
+// передаёт их строки ядру умножения, а векторные загрузки через границу
+// строки кеша заметно медленнее
+template <typename T>
+struct S21AlignedAllocator {
+  using value_type = T;
+  static constexpr std::size_t kAlignment = 64;
+
+  S21AlignedAllocator() = default;
+  template <typename U>
+  S21AlignedAllocator(const S21AlignedAllocator<U> &) {}
+
+  T *allocate(std::size_t count) {
+    return static_cast<T *>(::operator new(count * sizeof(T),
+                                           std::align_val_t(kAlignment)));
+  }
+  void deallocate(T *pointer, std::size_t) {
+    ::operator delete(pointer, std::align_val_t(kAlignment));
+  }
+  template <typename U>
+  bool operator==(const S21AlignedAllocator<U> &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const S21AlignedAllocator<U> &) const {
+    return false;
+  }
+};
+
+// LU-разложение с частичным выбором ведущего элемента: P * A = L * U.
+// Матрица хранится построчно в непрерывном массиве n x n, L и U
+// записываются на её место (единичная диагональ L не хранится).
+template <typename T>
+struct S21LUFactor {
+  int n = 0;
+  std::vector<T, S21AlignedAllocator<T>> lu;
+  std::vector<int> pivots;
+  int sign = 1;
+  bool singular = false;
+  // разложение остановилось на бесконечном или NaN ведущем элементе
+  bool nonfinite = false;
+};
+
+// Разложение на месте factor.lu, возвращает false для вырожденной матрицы
+template <typename T>
+bool S21LUDecompose(S21LUFactor<T> &factor) {
+  const int n = factor.n;
+  T *a = factor.lu.data();
+  factor.pivots.assign(n, 0);
+  factor.sign = 1;
+  factor.singular = false;
+  factor.nonfinite = false;
+  for (int k = 0; k < n; ++k) {
+    int pivot = k;
+    T best = std::fabs(a[static_cast<size_t>(k) * n + k]);
+    for (int i = k + 1; i < n; ++i) {
+      T value = std::fabs(a[static_cast<size_t>(i) * n + k]);
+      if (value > best) {
+        best = value;
+        pivot = i;
+      }
+    }
+    factor.pivots[k] = pivot;
+    if (best == T(0) || !std::isfinite(best)) {
+      factor.singular = true;
+      factor.nonfinite = !std::isfinite(best);
+      return false;
+    }
+    if (pivot != k) {
+      std::swap_ranges(a + static_cast<size_t>(k) * n,
+                       a + static_cast<size_t>(k + 1) * n,
+                       a + static_cast<size_t>(pivot) * n);
+      factor.sign = -factor.sign;
+    }
+    const T *row_k = a + static_cast<size_t>(k) * n;
+    for (int i = k + 1; i < n; ++i) {
+      T *row_i = a + static_cast<size_t>(i) * n;
+      T l = row_i[k] / row_k[k];
+      row_i[k] = l;
+      for (int j = k + 1; j < n; ++j) row_i[j] -= l * row_k[j];
+    }
+  }
+  return true;
+}
+
+// Решение A * X = B на месте для m правых частей, x - построчно n x m
+template <typename T>
+void S21LUSolve(const S21LUFactor<T> &factor, T *x, int m) {
+  const int n = factor.n;
+  const T *a = factor.lu.data();
+  for (int k = 0; k < n; ++k) {
+    int p = factor.pivots[k];
+    if (p != k) {
+      std::swap_ranges(x + static_cast<size_t>(k) * m,
+                       x + static_cast<size_t>(k + 1) * m,
+                       x + static_cast<size_t>(p) * m);
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    T *row_i = x + static_cast<size_t>(i) * m;
+    for (int k = 0; k < i; ++k) {
+      const T l = a[static_cast<size_t>(i) * n + k];
+      const T *row_k = x + static_cast<size_t>(k) * m;
+      for (int j = 0; j < m; ++j) row_i[j] -= l * row_k[j];
+    }
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    T *row_i = x + static_cast<size_t>(i) * m;
+    for (int k = i + 1; k < n; ++k) {
+      const T u = a[static_cast<size_t>(i) * n + k];
+      const T *row_k = x + static_cast<size_t>(k) * m;
+      for (int j = 0; j < m; ++j) row_i[j] -= u * row_k[j];
+    }
+    const T diag = a[static_cast<size_t>(i) * n + i];
+    for (int j = 0; j < m; ++j) row_i[j] /= diag;
+  }
+}
+
+// Решение A^T * X = B: A^T = U^T * L^T * P, перестановки применяются в
+// обратном порядке
+template <typename T>
+void S21LUSolveTransposed(const S21LUFactor<T> &factor, T *x, int m) {
+  const int n = factor.n;
+  const T *a = factor.lu.data();
+  for (int i = 0; i < n; ++i) {
+    T *row_i = x + static_cast<size_t>(i) * m;
+    for (int k = 0; k < i; ++k) {
+      const T u = a[static_cast<size_t>(k) * n + i];
+      const T *row_k = x + static_cast<size_t>(k) * m;
+      for (int j = 0; j < m; ++j) row_i[j] -= u * row_k[j];
+    }
+    const T diag = a[static_cast<size_t>(i) * n + i];
+    for (int j = 0; j < m; ++j) row_i[j] /= diag;
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    T *row_i = x + static_cast<size_t>(i) * m;
+    for (int k = i + 1; k < n; ++k) {
+      const T l = a[static_cast<size_t>(k) * n + i];
+      const T *row_k = x + static_cast<size_t>(k) * m;
+      for (int j = 0; j < m; ++j) row_i[j] -= l * row_k[j];
+    }
+  }
+  for (int k = n - 1; k >= 0; --k) {
+    int p = factor.pivots[k];
+    if (p != k) {
+      std::swap_ranges(x + static_cast<size_t>(k) * m,
+                       x + static_cast<size_t>(k + 1) * m,
+                       x + static_cast<size_t>(p) * m);
+    }
+  }
+}
+
+// Блочные варианты (s21_matrix_lu.cpp): хвост матрицы обновляется
+// многопоточным ядром умножения. Результат в том же формате, что у
+// S21LUDecompose и S21LUSolve; небольшие задачи передаются им.
+bool S21LUDecomposeBlocked(S21LUFactor<double> &factor);
+bool S21LUDecomposeBlocked(S21LUFactor<float> &factor);
+void S21LUSolveBlocked(const S21LUFactor<double> &factor, double *x, int m);
+void S21LUSolveBlocked(const S21LUFactor<float> &factor, float *x, int m);
+
+#endif  // S21_MATRIX_LU_H
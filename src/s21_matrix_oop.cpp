@@ -1,84 +1,236 @@
 #include "s21_matrix_oop.h"
 
+#include <functional>
+#include <vector>
+
+#include "s21_executor.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_lu.h"
+#include "s21_numa.h"
+#include "s21_result_cache.h"
+
+namespace {
+// начиная с этого порядка разложение по строке раздаётся задачам пула
+const int kParallelCofactorSize = 7;
+}  // namespace
+
 // Конструктор по умолчанию создает матрицу 1x1, заполненную 0
-S21Matrix::S21Matrix() : rows_(1), cols_(1) {
-  matrix_ = new double *[1];
-  matrix_[0] = new double[1];
-  matrix_[0][0] = 0.0;
+S21Matrix::S21Matrix()
+    : rows_(0),
+      cols_(0),
+      matrix_(nullptr),
+      data_(nullptr),
+      refs_(nullptr),
+      borrowed_(false) {
+  Allocate(1, 1);
 }
 
 // Параметризированный конструктор
 S21Matrix::S21Matrix(int rows, int cols)
-    : rows_(rows), cols_(cols), matrix_(nullptr) {
-  if (rows_ <= 0 || cols_ <= 0) {
+    : rows_(0),
+      cols_(0),
+      matrix_(nullptr),
+      data_(nullptr),
+      refs_(nullptr),
+      borrowed_(false) {
+  if (rows <= 0 || cols <= 0) {
     throw std::invalid_argument("Rows and columns must be positive integers");
   }
-
-  matrix_ = new double *[rows_]();
-  try {
-    for (int i = 0; i < rows_; ++i) {
-      matrix_[i] = new double[cols_]();
-    }
-  } catch (...) {
-    for (int k = 0; k < rows_; ++k) {
-      if (matrix_[k] != nullptr) {
-        delete[] matrix_[k];
-      }
-    }
-    delete[] matrix_;
-    matrix_ = nullptr;
-    throw;
-  }
+  Allocate(rows, cols);
 }
 
 // Конструктор переноса
 S21Matrix::S21Matrix(S21Matrix &&other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
-  other.rows_ = 0;
-  other.cols_ = 0;
-  other.matrix_ = nullptr;
+    : rows_(0),
+      cols_(0),
+      matrix_(nullptr),
+      data_(nullptr),
+      refs_(nullptr),
+      borrowed_(false) {
+  TakeFrom(other);
 };
 
 // Конструктор копирования
 S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
-  matrix_ = new double *[rows_];
-  try {
-    for (int i = 0; i < rows_; ++i) {
-      matrix_[i] = new double[cols_];
-      for (int j = 0; j < cols_; ++j) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
-    }
-  } catch (...) {
-    for (int k = 0; k < rows_; ++k) {
-      if (matrix_[k] != nullptr) {
-        delete[] matrix_[k];
-      }
-    }
-    delete[] matrix_;
-    matrix_ = nullptr;
-    throw;
+    : rows_(0),
+      cols_(0),
+      matrix_(nullptr),
+      data_(nullptr),
+      refs_(nullptr),
+      borrowed_(false) {
+  if (other.matrix_ == nullptr) return;
+  if (other.refs_ != nullptr) {
+    ShareFrom(other);
+  } else {
+    Allocate(other.rows_, other.cols_, other.data_);
   }
 }
 
 // Деструктор
-S21Matrix::~S21Matrix() {
+S21Matrix::~S21Matrix() { Release(); }
+
+// Выделение хранилища: элементы лежат одним блоком, matrix_ указывает на
+// начала строк. Маленькие матрицы размещаются во встроенном буфере объекта,
+// большие - по политике NUMA (s21_numa.h). Блок заполняется копией src или
+// нулями.
+void S21Matrix::Allocate(int rows, int cols, const double *src) {
+  size_t size = static_cast<size_t>(rows) * cols;
+  if (rows <= kInlineRows && size <= kInlineSize) {
+    data_ = inline_data_;
+    matrix_ = inline_rows_;
+    if (src != nullptr) {
+      std::copy(src, src + size, data_);
+    } else {
+      std::fill(data_, data_ + size, 0.0);
+    }
+  } else {
+    data_ = S21AllocateBuffer(rows, cols, src);
+    try {
+      matrix_ = new double *[rows];
+    } catch (...) {
+      S21FreeBuffer(data_);
+      data_ = nullptr;
+      throw;
+    }
+  }
+  rows_ = rows;
+  cols_ = cols;
   for (int i = 0; i < rows_; ++i) {
-    delete[] matrix_[i];
+    matrix_[i] = data_ + static_cast<size_t>(i) * cols_;
+  }
+}
+
+void S21Matrix::Release() {
+  // чужой буфер не освобождается, общее хранилище освобождает последний
+  // владелец
+  if (matrix_ != nullptr && !IsInline()) {
+    if (borrowed_) {
+      delete[] matrix_;
+    } else if (refs_ == nullptr ||
+               refs_->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      S21FreeBuffer(data_);
+      delete[] matrix_;
+      delete refs_;
+    }
+  }
+  refs_ = nullptr;
+  borrowed_ = false;
+  rows_ = 0;
+  cols_ = 0;
+  matrix_ = nullptr;
+  data_ = nullptr;
+}
+
+// Забирает хранилище other, оставляя его пустым. Встроенный буфер
+// копируется, кучу передаём без копирования.
+void S21Matrix::TakeFrom(S21Matrix &other) {
+  Release();
+  if (other.matrix_ == nullptr) return;
+  if (other.IsInline()) {
+    Allocate(other.rows_, other.cols_);
+    std::memcpy(data_, other.data_, sizeof(double) * rows_ * cols_);
+    other.Release();
+  } else {
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    matrix_ = other.matrix_;
+    data_ = other.data_;
+    refs_ = other.refs_;
+    borrowed_ = other.borrowed_;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.matrix_ = nullptr;
+    other.data_ = nullptr;
+    other.refs_ = nullptr;
+    other.borrowed_ = false;
+  }
+}
+
+// Становится ещё одним владельцем хранилища other, *this пуст
+void S21Matrix::ShareFrom(const S21Matrix &other) {
+  other.refs_->fetch_add(1, std::memory_order_relaxed);
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  matrix_ = other.matrix_;
+  data_ = other.data_;
+  refs_ = other.refs_;
+}
+
+// Представление чужого буфера: строки указывают в data, которая не
+// копируется и не освобождается
+S21Matrix S21Matrix::View(double *data, int rows, int cols) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument("Rows and columns must be positive integers");
+  }
+  if (data == nullptr) {
+    throw std::invalid_argument("View data must not be null.");
+  }
+  S21Matrix view;
+  view.Release();
+  view.matrix_ = new double *[rows];
+  view.data_ = data;
+  view.rows_ = rows;
+  view.cols_ = cols;
+  view.borrowed_ = true;
+  for (int i = 0; i < rows; ++i) {
+    view.matrix_[i] = data + static_cast<size_t>(i) * cols;
+  }
+  return view;
+}
+
+bool S21Matrix::IsView() const { return borrowed_; }
+
+void S21Matrix::EnableCopyOnWrite() {
+  if (matrix_ != nullptr && !IsInline() && !borrowed_ && refs_ == nullptr) {
+    refs_ = new std::atomic<int>(1);
+  }
+}
+
+bool S21Matrix::IsCopyOnWrite() const { return refs_ != nullptr; }
+
+bool S21Matrix::IsShared() const {
+  return refs_ != nullptr && refs_->load(std::memory_order_acquire) > 1;
+}
+
+// Заменяет общее хранилище собственной копией, которая тоже остаётся
+// в режиме копирования при записи
+void S21Matrix::Detach() {
+  if (!IsShared()) return;
+  S21Matrix copy;
+  copy.Release();
+  copy.Allocate(rows_, cols_, data_);
+  copy.EnableCopyOnWrite();
+  swap(copy);
+}
+
+void S21Matrix::PrepareOutput(int rows, int cols) {
+  if (matrix_ != nullptr && rows_ == rows && cols_ == cols) {
+    Detach();
+    return;
   }
-  delete[] matrix_;
+  S21Matrix result(rows, cols);
+  if (refs_ != nullptr) result.EnableCopyOnWrite();
+  swap(result);
 }
 
-// Индексация по элементам матрицы (строка, колонка)
-double &S21Matrix::operator()(int i, int j) {
-  CheckIndex(i, j);
-  return matrix_[i][j];
+void S21Matrix::StoreResult(S21Matrix &value) {
+  if (matrix_ != nullptr && rows_ == value.rows_ && cols_ == value.cols_) {
+    Detach();
+    std::copy(value.data_,
+              value.data_ + static_cast<size_t>(rows_) * cols_, data_);
+    return;
+  }
+  if (refs_ != nullptr) value.EnableCopyOnWrite();
+  swap(value);
 }
 
-const double &S21Matrix::operator()(int i, int j) const {
-  CheckIndex(i, j);
-  return matrix_[i][j];
+bool S21Matrix::Overlaps(const S21Matrix &other) const {
+  if (data_ == nullptr || other.data_ == nullptr) return false;
+  // std::less задаёт порядок и для указателей на разные массивы
+  std::less<const double *> less;
+  return less(data_, other.data_ + static_cast<size_t>(other.rows_) *
+                                       other.cols_) &&
+         less(other.data_, data_ + static_cast<size_t>(rows_) * cols_);
 }
 
 // Оператор присваивания
@@ -88,16 +240,21 @@ S21Matrix &S21Matrix::operator=(S21Matrix other) {
 }
 
 void S21Matrix::swap(S21Matrix &other) {
+  if (this == &other) return;
+  if (IsInline() || other.IsInline()) {
+    S21Matrix temp(std::move(other));
+    other.TakeFrom(*this);
+    TakeFrom(temp);
+    return;
+  }
   std::swap(rows_, other.rows_);
   std::swap(cols_, other.cols_);
   std::swap(matrix_, other.matrix_);
+  std::swap(data_, other.data_);
+  std::swap(refs_, other.refs_);
+  std::swap(borrowed_, other.borrowed_);
 }
 
-// Accessors
-int S21Matrix::getRows() const { return rows_; }
-int S21Matrix::getCols() const { return cols_; }
-double **S21Matrix::getMatrix() const { return matrix_; }
-
 // Mutator для rows_
 void S21Matrix::setRows(int new_rows) {
   if (new_rows <= 0) {
@@ -130,11 +287,11 @@ void S21Matrix::copyDataToTempMatrix(int new_rows, int new_cols) {
   *this = temp;
 }
 
-// для проверок входных данных
-void S21Matrix::CheckDimensions(const S21Matrix &other,
-                                const std::string &op) const {
+// для проверок входных данных; строка сообщения собирается только при ошибке
+void S21Matrix::CheckDimensions(const S21Matrix &other, const char *op) const {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
-    throw std::invalid_argument("Matrices must have the same dimensions" + op);
+    throw std::invalid_argument(
+        std::string("Matrices must have the same dimensions") + op);
   }
 }
 
@@ -145,10 +302,10 @@ void S21Matrix::CheckCompatibility(const S21Matrix &other) const {
   }
 }
 
-void S21Matrix::CheckIndex(int i, int j) const {
-  if (i >= rows_ || j >= cols_ || i < 0 || j < 0) {
-    throw std::out_of_range("Matrix indices are out of range");
-  }
+// редкий путь CheckIndex вынесен из заголовка, чтобы встраиваемая
+// проверка оставалась короткой
+void S21Matrix::ThrowIndexError() {
+  throw std::out_of_range("Matrix indices are out of range");
 }
 
 void S21Matrix::CheckPositiveDimensions(const S21Matrix &other) const {
@@ -183,14 +340,78 @@ S21Matrix S21Matrix::Multiply(const S21Matrix &other) const {
   CheckPositiveDimensions(other);
   CheckCompatibility(other);
   S21Matrix result(rows_, other.cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      result(i, j) = 0.0;
-      for (int k = 0; k < cols_; ++k) {
-        result(i, j) += (*this)(i, k) * other(k, j);
-      }
-    }
+  Gemm(1.0, *this, false, other, false, 0.0, result);
+  return result;
+}
+
+void S21Matrix::MultiplyInto(const S21Matrix &other, S21Matrix &out) const {
+  CheckPositiveDimensions(other);
+  CheckCompatibility(other);
+  if (out.Overlaps(*this) || out.Overlaps(other)) {
+    S21Matrix result(rows_, other.cols_);
+    MultiplyInto(other, result);
+    out.StoreResult(result);
+    return;
+  }
+  out.PrepareOutput(rows_, other.cols_);
+  S21GemmKernel(rows_, other.cols_, cols_, 1.0, matrix_, false, other.matrix_,
+                false, 0.0, out.matrix_);
+}
+
+// C = alpha * op(A) * op(B) + beta * C без промежуточных матриц
+void S21Matrix::Gemm(double alpha, const S21Matrix &a, bool trans_a,
+                     const S21Matrix &b, bool trans_b, double beta,
+                     S21Matrix &c) {
+  a.CheckPositiveDimensions(b);
+  c.CheckPositiveDimensions(c);
+  int m = trans_a ? a.cols_ : a.rows_;
+  int k = trans_a ? a.rows_ : a.cols_;
+  int n = trans_b ? b.rows_ : b.cols_;
+  if ((trans_b ? b.cols_ : b.rows_) != k) {
+    throw std::invalid_argument(
+        "Matrices cannot be multiplied: incompatible dimensions.");
+  }
+  if (c.rows_ != m || c.cols_ != n) {
+    throw std::invalid_argument(
+        "Result matrix has wrong dimensions for multiplication.");
   }
+  c.Detach();
+  if (c.Overlaps(a) || c.Overlaps(b)) {
+    // результат пересекается с аргументом (тот же объект или вид на его
+    // память) - считаем в отдельную матрицу
+    S21Matrix result(m, n);
+    std::copy(c.data_, c.data_ + static_cast<size_t>(m) * n, result.data_);
+    Gemm(alpha, a, trans_a, b, trans_b, beta, result);
+    c.StoreResult(result);
+    return;
+  }
+  S21GemmKernel(m, n, k, alpha, a.matrix_, trans_a, b.matrix_, trans_b, beta,
+                c.matrix_);
+}
+
+void S21Matrix::Syrk(double alpha, const S21Matrix &a, bool trans,
+                     double beta, S21Matrix &c) {
+  a.CheckPositiveDimensions(c);
+  int n = trans ? a.cols_ : a.rows_;
+  int k = trans ? a.rows_ : a.cols_;
+  if (c.rows_ != n || c.cols_ != n) {
+    throw std::invalid_argument(
+        "Result matrix has wrong dimensions for rank-k update.");
+  }
+  c.Detach();
+  if (c.Overlaps(a)) {
+    S21Matrix result(n, n);
+    std::copy(c.data_, c.data_ + static_cast<size_t>(n) * n, result.data_);
+    Syrk(alpha, a, trans, beta, result);
+    c.StoreResult(result);
+    return;
+  }
+  S21SyrkKernel(n, k, alpha, a.matrix_, trans, beta, c.matrix_);
+}
+
+S21Matrix S21Matrix::Gram() const {
+  S21Matrix result(cols_, cols_);
+  Syrk(1.0, *this, true, 0.0, result);
   return result;
 }
 
@@ -213,15 +434,141 @@ void S21Matrix::MulNumber(const double num) {
   }
 }
 
+// возведение в степень: двоичное возведение в квадрат на трёх заранее
+// выделенных буферах, swap кучи не копирует данные
+S21Matrix S21Matrix::Power(long long k) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to raise to a power.");
+  }
+  S21Matrix result(rows_, cols_);
+  if (k == 0) {
+    for (int i = 0; i < rows_; ++i) result.matrix_[i][i] = 1.0;
+    return result;
+  }
+  S21Matrix base = k < 0 ? InverseMatrix() : *this;
+  unsigned long long exponent =
+      k < 0 ? 0ULL - static_cast<unsigned long long>(k)
+            : static_cast<unsigned long long>(k);
+  S21Matrix temp(rows_, cols_);
+  bool has_result = false;
+  for (;;) {
+    if (exponent & 1ULL) {
+      if (has_result) {
+        Gemm(1.0, result, false, base, false, 0.0, temp);
+        result.swap(temp);
+      } else {
+        std::memcpy(result.data_, base.data_,
+                    sizeof(double) * rows_ * cols_);
+        has_result = true;
+      }
+    }
+    exponent >>= 1;
+    if (exponent == 0) break;
+    Gemm(1.0, base, false, base, false, 0.0, temp);
+    base.swap(temp);
+  }
+  return result;
+}
+
+// поэлементные свёртки: четыре независимых накопителя в блоке позволяют
+// компилятору векторизовать цикл без перестановки сложений
+namespace {
+template <typename Term>
+double BlockSum(const double *begin, const double *end, Term term) {
+  double acc[4] = {0.0, 0.0, 0.0, 0.0};
+  const double *p = begin;
+  for (; p + 4 <= end; p += 4) {
+    acc[0] += term(p[0]);
+    acc[1] += term(p[1]);
+    acc[2] += term(p[2]);
+    acc[3] += term(p[3]);
+  }
+  for (; p < end; ++p) acc[0] += term(*p);
+  return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+}  // namespace
+
+double S21Matrix::Sum() const {
+  return ReduceBlocks(
+      0.0,
+      [](const double *begin, const double *end) {
+        return BlockSum(begin, end, [](double x) { return x; });
+      },
+      [](double a, double b) { return a + b; }, true);
+}
+
+double S21Matrix::FrobeniusNorm() const {
+  return std::sqrt(ReduceBlocks(
+      0.0,
+      [](const double *begin, const double *end) {
+        return BlockSum(begin, end, [](double x) { return x * x; });
+      },
+      [](double a, double b) { return a + b; }, true));
+}
+
+double S21Matrix::MaxAbs() const {
+  return ReduceBlocks(
+      0.0,
+      [](const double *begin, const double *end) {
+        double best = 0.0;
+        for (const double *p = begin; p < end; ++p) {
+          best = std::max(best, std::fabs(*p));
+        }
+        return best;
+      },
+      [](double a, double b) { return std::max(a, b); }, true);
+}
+
+double S21Matrix::Trace() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to calculate trace.");
+  }
+  double trace = 0.0;
+  for (int i = 0; i < rows_; ++i) trace += matrix_[i][i];
+  return trace;
+}
+
 // сложение
+// Элемент читается перед записью на то же место, поэтому out может
+// совпадать с аргументом. Частичное пересечение (представления со сдвигом)
+// считается во временную матрицу.
+template <typename Op>
+void S21Matrix::ElementwiseInto(const S21Matrix &other, S21Matrix &out,
+                                Op op) const {
+  auto same_place = [&out](const S21Matrix &arg) {
+    return out.data_ == arg.data_ && out.rows_ == arg.rows_ &&
+           out.cols_ == arg.cols_;
+  };
+  if ((out.Overlaps(*this) && !same_place(*this)) ||
+      (out.Overlaps(other) && !same_place(other))) {
+    S21Matrix result(rows_, cols_);
+    ElementwiseInto(other, result, op);
+    out.StoreResult(result);
+    return;
+  }
+  out.PrepareOutput(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    const double *a = matrix_[i];
+    const double *b = other.matrix_[i];
+    double *row = out.matrix_[i];
+    for (int j = 0; j < cols_; ++j) row[j] = op(a[j], b[j]);
+  }
+}
+
+void S21Matrix::SumInto(const S21Matrix &other, S21Matrix &out) const {
+  CheckDimensions(other, "addition");
+  ElementwiseInto(other, out, std::plus<double>());
+}
+
+void S21Matrix::SubInto(const S21Matrix &other, S21Matrix &out) const {
+  CheckDimensions(other, "subtraction");
+  ElementwiseInto(other, out, std::minus<double>());
+}
+
 S21Matrix S21Matrix::Sumtract(const S21Matrix &other) const {
   CheckDimensions(other, "addition");
   S21Matrix result(rows_, cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result(i, j) = (*this)(i, j) + other(i, j);
-    }
-  }
+  SumInto(other, result);
   return result;
 }
 
@@ -240,11 +587,7 @@ void S21Matrix::SumMatrix(const S21Matrix &other) { *this = Sumtract(other); }
 S21Matrix S21Matrix::Subtract(const S21Matrix &other) const {
   CheckDimensions(other, "subtraction");
   S21Matrix result(rows_, cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result(i, j) = (*this)(i, j) - other(i, j);
-    }
-  }
+  SubInto(other, result);
   return result;
 }
 
@@ -262,12 +605,21 @@ void S21Matrix::SubMatrix(const S21Matrix &other) { *this = Subtract(other); }
 // транспонирование
 S21Matrix S21Matrix::Transpose() const {
   S21Matrix transposed(cols_, rows_);
+  TransposeInto(transposed);
+  return transposed;
+}
+
+void S21Matrix::TransposeInto(S21Matrix &out) const {
+  if (out.Overlaps(*this)) {
+    S21Matrix result(cols_, rows_);
+    TransposeInto(result);
+    out.StoreResult(result);
+    return;
+  }
+  out.PrepareOutput(cols_, rows_);
   for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      transposed(j, i) = (*this)(i, j);
-    }
+    for (int j = 0; j < cols_; ++j) out.matrix_[j][i] = matrix_[i][j];
   }
-  return transposed;
 }
 // определитель
 double S21Matrix::Determinant() const {
@@ -275,34 +627,81 @@ double S21Matrix::Determinant() const {
     throw std::invalid_argument(
         "Matrix must be square to calculate determinant.");
   }
+  // до 2x2 посчитать быстрее, чем найти в кеше
+  if (rows_ <= 2) return ExpandDeterminant();
+  S21Matrix det = S21CachedResult(S21CachedOp::kDeterminant, *this, [this]() {
+    // произведение диагонали U блочного LU-разложения; вырождена матрица
+    // только при нулевом ведущем элементе, бесконечный или NaN дают NaN
+    S21LUFactor<double> factor;
+    factor.n = rows_;
+    factor.lu.assign(data_, data_ + static_cast<size_t>(rows_) * cols_);
+    S21Matrix value(1, 1);
+    if (S21LUDecomposeBlocked(factor)) {
+      value(0, 0) = factor.sign;
+      for (int i = 0; i < rows_; ++i) {
+        value(0, 0) *= factor.lu[static_cast<size_t>(i) * rows_ + i];
+      }
+    } else if (factor.nonfinite) {
+      value(0, 0) = NAN;
+    }
+    return value;
+  });
+  return det(0, 0);
+}
+
+double S21Matrix::ExpandDeterminant() const {
   if (rows_ == 1) {
     return (*this)(0, 0);
   }
   if (rows_ == 2) {
     return (*this)(0, 0) * (*this)(1, 1) - (*this)(0, 1) * (*this)(1, 0);
   }
-  double det = 0.0;
-  for (int j = 0; j < cols_; ++j) {
+  auto term = [this](int j) {
     S21Matrix minor_matrix = GetMinor(0, j);
-    double minor_det = minor_matrix.Determinant();
+    double minor_det = minor_matrix.ExpandDeterminant();
     double sign = (j % 2 == 0) ? 1.0 : -1.0;
-    det += sign * (*this)(0, j) * minor_det;
+    return sign * (*this)(0, j) * minor_det;
+  };
+  // суммируем в фиксированном порядке, чтобы результат не зависел от потоков
+  double det = 0.0;
+  if (rows_ >= kParallelCofactorSize) {
+    std::vector<double> terms(cols_);
+    S21TaskGroup group;
+    for (int j = 0; j < cols_; ++j) {
+      group.Run([&term, &terms, j]() { terms[j] = term(j); });
+    }
+    group.Wait();
+    for (int j = 0; j < cols_; ++j) det += terms[j];
+  } else {
+    // без массива слагаемых: миноры до 4x4 не обращаются к куче
+    for (int j = 0; j < cols_; ++j) det += term(j);
   }
   return det;
 }
 // миноры
 S21Matrix S21Matrix::GetMinor(int row, int col) const {
+  CheckIndex(row, col);
   S21Matrix minor(rows_ - 1, cols_ - 1);
+  GetMinorInto(row, col, minor);
+  return minor;
+}
+
+void S21Matrix::GetMinorInto(int row, int col, S21Matrix &out) const {
+  CheckIndex(row, col);
+  if (out.Overlaps(*this)) {
+    S21Matrix result(rows_ - 1, cols_ - 1);
+    GetMinorInto(row, col, result);
+    out.StoreResult(result);
+    return;
+  }
+  out.PrepareOutput(rows_ - 1, cols_ - 1);
   for (int i = 0, minor_i = 0; i < rows_; ++i) {
     if (i == row) continue;
-    for (int j = 0, minor_j = 0; j < cols_; ++j) {
-      if (j == col) continue;
-      minor(minor_i, minor_j) = (*this)(i, j);
-      ++minor_j;
-    }
-    ++minor_i;
+    const double *src = matrix_[i];
+    double *dst = out.matrix_[minor_i++];
+    std::copy(src, src + col, dst);
+    std::copy(src + col + 1, src + cols_, dst + col);
   }
-  return minor;
 }
 // матрица алгебраических дополнений
 S21Matrix S21Matrix::CalcComplements() const {
@@ -310,24 +709,41 @@ S21Matrix S21Matrix::CalcComplements() const {
     throw std::invalid_argument(
         "Matrix must be square to calculate complements.");
   }
-  S21Matrix complements(rows_, cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      S21Matrix minor = this->GetMinor(i, j);
-      double cofactor = (i + j) % 2 == 0 ? 1.0 : -1.0;
-      complements(i, j) = cofactor * minor.Determinant();
-    }
-  }
-  return complements;
+  return S21CachedResult(S21CachedOp::kComplements, *this, [this]() {
+    S21Matrix complements(rows_, cols_);
+    CalcComplementsInto(complements);
+    return complements;
+  });
 }
-// обратная матрица
-S21Matrix S21Matrix::InverseMatrix() const {
-  double det = this->Determinant();
-  if (det == 0) {
-    throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+
+void S21Matrix::CalcComplementsInto(S21Matrix &out) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Matrix must be square to calculate complements.");
+  }
+  if (out.Overlaps(*this)) {
+    S21Matrix result(rows_, cols_);
+    CalcComplementsInto(result);
+    out.StoreResult(result);
+    return;
+  }
+  out.PrepareOutput(rows_, cols_);
+  auto complement = [this, &out](int i, int j) {
+    S21Matrix minor = this->GetMinor(i, j);
+    double cofactor = (i + j) % 2 == 0 ? 1.0 : -1.0;
+    out.matrix_[i][j] = cofactor * minor.ExpandDeterminant();
+  };
+  if (rows_ >= kParallelCofactorSize) {
+    S21TaskGroup group;
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        group.Run([&complement, i, j]() { complement(i, j); });
+      }
+    }
+    group.Wait();
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) complement(i, j);
+    }
   }
-  S21Matrix complements = this->CalcComplements();
-  S21Matrix transposedComplements = complements.Transpose();
-  transposedComplements.MulNumber(1.0 / det);
-  return transposedComplements;
 }
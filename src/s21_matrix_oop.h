@@ -3,13 +3,71 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
+
+#include "s21_future.h"
+#include "s21_parallel.h"
+
+// точность разложения в Solve и InverseMatrix: kMixed раскладывает матрицу
+// во float и уточняет решение в double
+enum class S21Precision { kDouble, kMixed };
+
+// формат текстового файла матрицы; kAuto определяет его по первой строке
+enum class S21TextFormat { kAuto, kCsv, kWhitespace, kMatrixMarket };
+
+struct S21SvdResult;
 
 class S21Matrix {
  private:
+  // матрицы до 4x4 хранятся внутри объекта без обращения к куче
+  static constexpr int kInlineRows = 4;
+  static constexpr int kInlineSize = 16;
+
   int rows_, cols_;
   double **matrix_;
+  double *data_;
+  double inline_data_[kInlineSize];
+  double *inline_rows_[kInlineRows];
+  // счётчик владельцев общего хранилища, nullptr - копирование при записи
+  // не включено
+  std::atomic<int> *refs_;
+  // data_ принадлежит вызывающему (View), освобождаются только строки
+  bool borrowed_;
+
+  // поэлементные операции делят данные на блоки фиксированного размера,
+  // поэтому частичные суммы не зависят от числа потоков
+  static constexpr size_t kElementBlock = 4096;
+  static constexpr size_t kParallelElements = 1 << 16;
+
+  void Allocate(int rows, int cols, const double *src = nullptr);
+  void Release();
+  void TakeFrom(S21Matrix &other);
+  bool IsInline() const;
+  [[noreturn]] static void ThrowIndexError();
+  void ShareFrom(const S21Matrix &other);
+  // разложение по первой строке, без проверок и кеша
+  double ExpandDeterminant() const;
+  // Готовит матрицу к записи результата rows x cols: при совпадающем
+  // размере хранилище сохраняется (разделённое отделяется), иначе
+  // выделяется новое
+  void PrepareOutput(int rows, int cols);
+  // копирует value в уже подходящее хранилище или забирает его
+  void StoreResult(S21Matrix &value);
+  // пересекаются ли данные двух матриц
+  bool Overlaps(const S21Matrix &other) const;
+  template <typename Op>
+  void ElementwiseInto(const S21Matrix &other, S21Matrix &out, Op op) const;
+
+  template <typename Body>
+  void ForEachBlock(bool parallel, Body body) const;
+  template <typename Block, typename Combine>
+  double ReduceBlocks(double init, Block block, Combine combine,
+                      bool parallel) const;
 
  public:
   S21Matrix();
@@ -31,7 +89,26 @@ class S21Matrix {
   void setRows(int new_rows);
   void copyDataToTempMatrix(int new_rows, int new_cols);
 
-  void CheckDimensions(const S21Matrix &other, const std::string &op) const;
+  // Матрица над чужим непрерывным буфером rows x cols (по строкам) без
+  // копирования, например над памятью массива NumPy. Буфер должен пережить
+  // матрицу. Копия представления владеет своими данными, а операции,
+  // заменяющие хранилище (присваивание, setRows, MulMatrix...), отвязывают
+  // матрицу от буфера.
+  static S21Matrix View(double *data, int rows, int cols);
+  bool IsView() const;
+
+  // Копирование при записи: после EnableCopyOnWrite копии матрицы делят
+  // хранилище со счётчиком ссылок, а изменение через неконстантные методы
+  // сначала отделяет свою копию. Матрицы во встроенном буфере копируются
+  // как обычно, для представлений View режим не включается. Запись через
+  // getMatrix() хранилище не отделяет - перед ней нужно вызвать Detach().
+  void EnableCopyOnWrite();
+  bool IsCopyOnWrite() const;
+  // true, если хранилище сейчас разделено с другой матрицей
+  bool IsShared() const;
+  void Detach();
+
+  void CheckDimensions(const S21Matrix &other, const char *op) const;
   void CheckCompatibility(const S21Matrix &other) const;
   void CheckPositiveDimensions(const S21Matrix &other) const;
   void CheckIndex(int i, int j) const;
@@ -54,12 +131,180 @@ class S21Matrix {
   S21Matrix &operator*=(const S21Matrix &other);
   void MulMatrix(const S21Matrix &other);
   void MulNumber(const double num);
+  S21Matrix Power(long long k) const;
+
+  // x = func(x) для каждого элемента
+  template <typename F>
+  void Apply(F func, bool parallel = true);
+  // x = func(x, y) для соответствующих элементов other
+  template <typename F>
+  void Zip(const S21Matrix &other, F func, bool parallel = true);
+  // свёртка op(...op(init, x0)...), op должна быть ассоциативной
+  template <typename Op>
+  double Reduce(double init, Op op, bool parallel = true) const;
+  double Sum() const;
+  double FrobeniusNorm() const;
+  double MaxAbs() const;
+  double Trace() const;
+  static void Gemm(double alpha, const S21Matrix &a, bool trans_a,
+                   const S21Matrix &b, bool trans_b, double beta,
+                   S21Matrix &c);
+  // C = alpha * op(A) * op(A)^T + beta * C, op(A) = A^T при trans. Из C
+  // читается только нижний треугольник, результат симметричен.
+  static void Syrk(double alpha, const S21Matrix &a, bool trans, double beta,
+                   S21Matrix &c);
+  // A^T * A без транспонированной копии и вдвое меньшим числом операций
+  S21Matrix Gram() const;
 
   double Determinant() const;
   S21Matrix GetMinor(int row, int col) const;
   S21Matrix Transpose() const;
   S21Matrix CalcComplements() const;
   S21Matrix InverseMatrix() const;
+
+  // Варианты с результатом в out для циклов без выделения памяти.
+  // Хранилище out переиспользуется, если размер уже подходит, иначе
+  // выделяется заново; представление View подходящего размера остаётся над
+  // своим буфером. out может совпадать с аргументом или пересекаться с ним:
+  // тогда результат считается во временную матрицу. Кеш результатов не
+  // используется. При ошибке проверки размеров out не меняется.
+  void SumInto(const S21Matrix &other, S21Matrix &out) const;
+  void SubInto(const S21Matrix &other, S21Matrix &out) const;
+  void MultiplyInto(const S21Matrix &other, S21Matrix &out) const;
+  void TransposeInto(S21Matrix &out) const;
+  void GetMinorInto(int row, int col, S21Matrix &out) const;
+  // миноры до 4x4 хранятся во встроенном буфере, поэтому без выделений
+  // работает для матриц до 5x5
+  void CalcComplementsInto(S21Matrix &out) const;
+  // LU-разложение переиспользуется потоком для матриц до 512x512, память
+  // больших разложений освобождается после вызова
+  void InverseMatrixInto(S21Matrix &out) const;
+
+  // отвергает матрицы с оценкой 1 / cond_1(A) меньше rcond_threshold
+  S21Matrix InverseMatrix(double rcond_threshold) const;
+  S21Matrix InverseMatrix(S21Precision precision) const;
+  double ConditionEstimate() const;
+  std::vector<double> EigenSymmetric() const;
+  std::vector<double> EigenSymmetric(S21Matrix &vectors) const;
+  // старшие rank сингулярных троек рандомизированным методом за O(mnk)
+  S21SvdResult TruncatedSvd(int rank, int oversampling = 10,
+                            int power_iterations = 2,
+                            unsigned long long seed = 0) const;
+  S21Matrix Solve(const S21Matrix &b,
+                  S21Precision precision = S21Precision::kDouble) const;
+
+  static S21Matrix LoadText(const std::string &path,
+                            S21TextFormat format = S21TextFormat::kAuto,
+                            bool parallel = true);
+  void SaveText(const std::string &path,
+                S21TextFormat format = S21TextFormat::kCsv) const;
+
+  S21Future<S21Matrix> MultiplyAsync(const S21Matrix &other) const;
+  S21Future<S21Matrix> InverseAsync(
+      S21Precision precision = S21Precision::kDouble) const;
+  S21Future<S21Matrix> SolveAsync(
+      const S21Matrix &b, S21Precision precision = S21Precision::kDouble) const;
+  S21Future<S21Matrix> CalcComplementsAsync() const;
+  S21Future<double> DeterminantAsync() const;
 };
 
+// Доступ к элементам и размерам вызывается во внутренних циклах, поэтому
+// определён здесь и встраивается в вызывающий код
+inline bool S21Matrix::IsInline() const { return matrix_ == inline_rows_; }
+
+inline int S21Matrix::getRows() const { return rows_; }
+inline int S21Matrix::getCols() const { return cols_; }
+inline double **S21Matrix::getMatrix() const { return matrix_; }
+
+inline void S21Matrix::CheckIndex(int i, int j) const {
+  // одно беззнаковое сравнение отсекает и отрицательные индексы
+  if (static_cast<unsigned>(i) >= static_cast<unsigned>(rows_) ||
+      static_cast<unsigned>(j) >= static_cast<unsigned>(cols_)) {
+    ThrowIndexError();
+  }
+}
+
+// Индексация по элементам матрицы (строка, колонка)
+inline double &S21Matrix::operator()(int i, int j) {
+  CheckIndex(i, j);
+  if (refs_ != nullptr) Detach();
+  return matrix_[i][j];
+}
+
+inline const double &S21Matrix::operator()(int i, int j) const {
+  CheckIndex(i, j);
+  return matrix_[i][j];
+}
+
+// A ~ u * diag(s) * v^T, сингулярные числа по убыванию
+struct S21SvdResult {
+  S21Matrix u;
+  std::vector<double> s;
+  S21Matrix v;
+};
+
+template <typename Body>
+void S21Matrix::ForEachBlock(bool parallel, Body body) const {
+  const size_t size = static_cast<size_t>(rows_) * cols_;
+  const int blocks =
+      static_cast<int>((size + kElementBlock - 1) / kElementBlock);
+  auto run = [size, &body](int first, int last) {
+    body(first * kElementBlock, std::min(size, last * kElementBlock));
+  };
+  if (parallel && size >= kParallelElements) {
+    S21ParallelFor(0, blocks, 1, run);
+  } else {
+    run(0, blocks);
+  }
+}
+
+template <typename Block, typename Combine>
+double S21Matrix::ReduceBlocks(double init, Block block, Combine combine,
+                               bool parallel) const {
+  const size_t size = static_cast<size_t>(rows_) * cols_;
+  std::vector<double> partial((size + kElementBlock - 1) / kElementBlock);
+  ForEachBlock(parallel, [this, size, &block, &partial](size_t from,
+                                                        size_t to) {
+    for (size_t start = from; start < to; start += kElementBlock) {
+      size_t end = std::min(size, start + kElementBlock);
+      partial[start / kElementBlock] = block(data_ + start, data_ + end);
+    }
+  });
+  double result = init;
+  for (double value : partial) result = combine(result, value);
+  return result;
+}
+
+template <typename F>
+void S21Matrix::Apply(F func, bool parallel) {
+  Detach();
+  double *data = data_;
+  ForEachBlock(parallel, [data, &func](size_t from, size_t to) {
+    for (size_t k = from; k < to; ++k) data[k] = func(data[k]);
+  });
+}
+
+template <typename F>
+void S21Matrix::Zip(const S21Matrix &other, F func, bool parallel) {
+  CheckDimensions(other, "zip");
+  Detach();
+  double *data = data_;
+  const double *src = other.data_;
+  ForEachBlock(parallel, [data, src, &func](size_t from, size_t to) {
+    for (size_t k = from; k < to; ++k) data[k] = func(data[k], src[k]);
+  });
+}
+
+template <typename Op>
+double S21Matrix::Reduce(double init, Op op, bool parallel) const {
+  return ReduceBlocks(
+      init,
+      [&op](const double *begin, const double *end) {
+        double acc = *begin;
+        for (const double *p = begin + 1; p < end; ++p) acc = op(acc, *p);
+        return acc;
+      },
+      op, parallel);
+}
+
 #endif  // s21_matrix_oop_H
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+#include "s21_matrix_lu.h"
+#include "s21_matrix_oop.h"
+#include "s21_result_cache.h"
+
+namespace {
+// как в LAPACK dsgesv: после 30 уточнений считаем, что float не справился
+const int kMaxRefinements = 30;
+
+// по умолчанию InverseMatrix отвергает матрицы с 1 / cond_1(A) < eps
+const double kDefaultRcondThreshold = DBL_EPSILON;
+// число итераций оценщика Хэйгера-Хайэма, как в LAPACK dlacn2
+const int kNormEstimateIterations = 5;
+// разложение потока сохраняется между вызовами только до этого размера
+// (512 x 512, 2 МБ); для больших матриц выделение теряется на фоне O(n^3)
+const size_t kKeptFactorElements = 512 * 512;
+
+bool FactorDouble(const S21Matrix &a, S21LUFactor<double> &factor) {
+  const int n = a.getRows();
+  factor.n = n;
+  factor.lu.resize(static_cast<size_t>(n) * n);
+  for (int i = 0; i < n; ++i) {
+    const double *row = a.getMatrix()[i];
+    std::copy(row, row + n, &factor.lu[static_cast<size_t>(i) * n]);
+  }
+  return S21LUDecomposeBlocked(factor);
+}
+
+S21Matrix SolveFactored(const S21LUFactor<double> &factor,
+                        const S21Matrix &b) {
+  const int n = factor.n;
+  const int m = b.getCols();
+  std::vector<double, S21AlignedAllocator<double>> x(
+      static_cast<size_t>(n) * m);
+  for (int i = 0; i < n; ++i) {
+    const double *row = b.getMatrix()[i];
+    std::copy(row, row + m, &x[static_cast<size_t>(i) * m]);
+  }
+  S21LUSolveBlocked(factor, x.data(), m);
+  S21Matrix result(n, m);
+  for (int i = 0; i < n; ++i) {
+    const double *row = &x[static_cast<size_t>(i) * m];
+    std::copy(row, row + m, result.getMatrix()[i]);
+  }
+  return result;
+}
+
+S21Matrix SolveDouble(const S21Matrix &a, const S21Matrix &b) {
+  S21LUFactor<double> factor;
+  if (!FactorDouble(a, factor)) {
+    throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+  }
+  return SolveFactored(factor, b);
+}
+
+double Norm1(const S21Matrix &a) {
+  // рабочие векторы здесь и в оценщике принадлежат потоку: вызовы не
+  // ждут задач пула и не могут вложиться друг в друга
+  thread_local std::vector<double> sums;
+  sums.assign(a.getCols(), 0.0);
+  for (int i = 0; i < a.getRows(); ++i) {
+    for (int j = 0; j < a.getCols(); ++j) {
+      sums[j] += std::fabs(a.getMatrix()[i][j]);
+    }
+  }
+  double norm = 0.0;
+  for (double sum : sums) norm = std::max(norm, sum);
+  return norm;
+}
+
+double VectorNorm1(const std::vector<double> &x) {
+  double norm = 0.0;
+  for (double value : x) norm += std::fabs(value);
+  return norm;
+}
+
+// оценка ||A^-1||_1 по готовому LU за O(n^2): метод Хэйгера с
+// дополнительным вектором Хайэма (LAPACK dlacn2)
+double EstimateInverseNorm1(const S21LUFactor<double> &factor) {
+  const int n = factor.n;
+  thread_local std::vector<double> x, signs, y, z;
+  x.assign(n, 1.0 / n);
+  signs.assign(n, 0.0);
+  double estimate = 0.0;
+  for (int iter = 0; iter < kNormEstimateIterations; ++iter) {
+    y.assign(x.begin(), x.end());
+    S21LUSolve(factor, y.data(), 1);
+    double norm = VectorNorm1(y);
+    if (iter > 0 && norm <= estimate) break;
+    estimate = norm;
+    bool same_signs = true;
+    for (int i = 0; i < n; ++i) {
+      double sign = y[i] >= 0.0 ? 1.0 : -1.0;
+      if (sign != signs[i]) same_signs = false;
+      signs[i] = sign;
+    }
+    if (iter > 0 && same_signs) break;
+    z.assign(signs.begin(), signs.end());
+    S21LUSolveTransposed(factor, z.data(), 1);
+    int best = 0;
+    double z_dot_x = 0.0;
+    for (int i = 0; i < n; ++i) {
+      if (std::fabs(z[i]) > std::fabs(z[best])) best = i;
+      z_dot_x += z[i] * x[i];
+    }
+    if (iter > 0 && std::fabs(z[best]) <= z_dot_x) break;
+    std::fill(x.begin(), x.end(), 0.0);
+    x[best] = 1.0;
+  }
+  // знакопеременный вектор ловит случаи, на которых метод Хэйгера ошибается
+  std::vector<double> &alternating = y;
+  for (int i = 0; i < n; ++i) {
+    double magnitude = n > 1 ? 1.0 + static_cast<double>(i) / (n - 1) : 1.0;
+    alternating[i] = i % 2 == 0 ? magnitude : -magnitude;
+  }
+  S21LUSolve(factor, alternating.data(), 1);
+  return std::max(estimate, 2.0 * VectorNorm1(alternating) / (3.0 * n));
+}
+
+// Разложение потока для InverseMatrixInto. Ожидающий поток выполняет
+// чужие задачи пула, и вложенный вызов в том же потоке получает своё
+// временное разложение. Память больше kKeptFactorElements освобождается
+// после вызова.
+class ThreadFactor {
+ public:
+  ThreadFactor() : owner_(!busy_) { busy_ = true; }
+  ~ThreadFactor() {
+    if (!owner_) return;
+    if (shared_.lu.capacity() > kKeptFactorElements) {
+      decltype(shared_.lu)().swap(shared_.lu);
+      std::vector<int>().swap(shared_.pivots);
+    }
+    busy_ = false;
+  }
+  ThreadFactor(const ThreadFactor &) = delete;
+  ThreadFactor &operator=(const ThreadFactor &) = delete;
+
+  S21LUFactor<double> &get() { return owner_ ? shared_ : local_; }
+
+ private:
+  static thread_local bool busy_;
+  static thread_local S21LUFactor<double> shared_;
+  bool owner_;
+  S21LUFactor<double> local_;
+};
+
+thread_local bool ThreadFactor::busy_ = false;
+thread_local S21LUFactor<double> ThreadFactor::shared_;
+
+// разложение во float, false если матрица не представима или вырождена
+bool FactorFloat(const S21Matrix &a, S21LUFactor<float> &factor) {
+  const int n = a.getRows();
+  factor.n = n;
+  factor.lu.resize(static_cast<size_t>(n) * n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double value = a.getMatrix()[i][j];
+      if (std::fabs(value) > FLT_MAX) return false;
+      factor.lu[static_cast<size_t>(i) * n + j] = static_cast<float>(value);
+    }
+  }
+  return S21LUDecomposeBlocked(factor);
+}
+
+// поправка d = A^-1 * r во float, прибавляется к x
+bool AddFloatCorrection(const S21LUFactor<float> &factor, const S21Matrix &r,
+                        S21Matrix &x) {
+  const int n = r.getRows();
+  const int m = r.getCols();
+  std::vector<float> d(static_cast<size_t>(n) * m);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < m; ++j) {
+      double value = r.getMatrix()[i][j];
+      if (std::fabs(value) > FLT_MAX) return false;
+      d[static_cast<size_t>(i) * m + j] = static_cast<float>(value);
+    }
+  }
+  S21LUSolveBlocked(factor, d.data(), m);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < m; ++j) {
+      if (!std::isfinite(d[static_cast<size_t>(i) * m + j])) return false;
+      x.getMatrix()[i][j] += d[static_cast<size_t>(i) * m + j];
+    }
+  }
+  return true;
+}
+
+double NormInf(const S21Matrix &a) {
+  double norm = 0.0;
+  for (int i = 0; i < a.getRows(); ++i) {
+    double sum = 0.0;
+    for (int j = 0; j < a.getCols(); ++j) sum += std::fabs(a.getMatrix()[i][j]);
+    norm = std::max(norm, sum);
+  }
+  return norm;
+}
+
+// критерий сходимости dsgesv для каждого столбца: |r| <= |x| * |A| * eps
+// * sqrt(n)
+bool Converged(const S21Matrix &r, const S21Matrix &x, double threshold) {
+  for (int j = 0; j < r.getCols(); ++j) {
+    double r_norm = 0.0;
+    double x_norm = 0.0;
+    for (int i = 0; i < r.getRows(); ++i) {
+      r_norm = std::max(r_norm, std::fabs(r.getMatrix()[i][j]));
+      x_norm = std::max(x_norm, std::fabs(x.getMatrix()[i][j]));
+    }
+    if (!(r_norm <= x_norm * threshold)) return false;
+  }
+  return true;
+}
+
+// разложение во float и итерационное уточнение в double
+bool SolveMixed(const S21Matrix &a, const S21Matrix &b, S21Matrix &x) {
+  S21LUFactor<float> factor;
+  if (!FactorFloat(a, factor)) return false;
+  if (!AddFloatCorrection(factor, b, x)) return false;
+  const double threshold =
+      NormInf(a) * DBL_EPSILON * std::sqrt(static_cast<double>(a.getRows()));
+  for (int iter = 0; iter < kMaxRefinements; ++iter) {
+    S21Matrix r = b;
+    S21Matrix::Gemm(-1.0, a, false, x, false, 1.0, r);
+    if (Converged(r, x, threshold)) return true;
+    if (!AddFloatCorrection(factor, r, x)) return false;
+  }
+  return false;
+}
+}  // namespace
+
+// решение системы A * X = B
+S21Matrix S21Matrix::Solve(const S21Matrix &b, S21Precision precision) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to solve a system.");
+  }
+  if (b.rows_ != rows_) {
+    throw std::invalid_argument(
+        "Right-hand side must have as many rows as the matrix.");
+  }
+  if (precision == S21Precision::kMixed) {
+    S21Matrix x(b.rows_, b.cols_);
+    if (SolveMixed(*this, b, x)) return x;
+    // плохая обусловленность: повторяем полностью в double
+  }
+  return SolveDouble(*this, b);
+}
+
+// обратная матрица через LU; почти вырожденные матрицы отвергаются по
+// оценке обратного числа обусловленности
+S21Matrix S21Matrix::InverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to calculate inverse.");
+  }
+  return S21CachedResult(S21CachedOp::kInverse, *this, [this]() {
+    return InverseMatrix(kDefaultRcondThreshold);
+  });
+}
+
+S21Matrix S21Matrix::InverseMatrix(double rcond_threshold) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to calculate inverse.");
+  }
+  S21LUFactor<double> factor;
+  if (!FactorDouble(*this, factor) ||
+      1.0 / (Norm1(*this) * EstimateInverseNorm1(factor)) < rcond_threshold) {
+    throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+  }
+  S21Matrix identity(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) identity.matrix_[i][i] = 1.0;
+  return SolveFactored(factor, identity);
+}
+
+void S21Matrix::InverseMatrixInto(S21Matrix &out) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to calculate inverse.");
+  }
+  if (out.Overlaps(*this)) {
+    S21Matrix result(rows_, cols_);
+    InverseMatrixInto(result);
+    out.StoreResult(result);
+    return;
+  }
+  ThreadFactor scratch;
+  S21LUFactor<double> &factor = scratch.get();
+  if (!FactorDouble(*this, factor) ||
+      1.0 / (Norm1(*this) * EstimateInverseNorm1(factor)) <
+          kDefaultRcondThreshold) {
+    throw std::invalid_argument("Matrix is singular and cannot be inverted.");
+  }
+  out.PrepareOutput(rows_, cols_);
+  // строки out лежат подряд, решение идёт прямо в его хранилище
+  std::fill(out.data_, out.data_ + static_cast<size_t>(rows_) * cols_, 0.0);
+  for (int i = 0; i < rows_; ++i) out.matrix_[i][i] = 1.0;
+  S21LUSolveBlocked(factor, out.data_, cols_);
+}
+
+// оценка cond_1(A) = ||A||_1 * ||A^-1||_1 без вычисления A^-1
+double S21Matrix::ConditionEstimate() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Matrix must be square to estimate condition number.");
+  }
+  S21LUFactor<double> factor;
+  if (!FactorDouble(*this, factor)) return INFINITY;
+  return Norm1(*this) * EstimateInverseNorm1(factor);
+}
+
+S21Matrix S21Matrix::InverseMatrix(S21Precision precision) const {
+  if (precision == S21Precision::kDouble) {
+    return InverseMatrix();
+  }
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to calculate inverse.");
+  }
+  S21Matrix identity(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) identity.matrix_[i][i] = 1.0;
+  S21Matrix x(rows_, cols_);
+  // после уточнения A^-1 уже найдена, и rcond считается по ней точно
+  if (SolveMixed(*this, identity, x) &&
+      1.0 / (Norm1(*this) * Norm1(x)) >= kDefaultRcondThreshold) {
+    return x;
+  }
+  // не сошлось или почти вырождена: путь double с той же проверкой
+  return InverseMatrix();
+}
@@ -0,0 +1,190 @@
+#include "s21_matrix_status.h"
+
+#include <cmath>
+
+namespace {
+bool IsEmpty(const S21Matrix &m) {
+  return m.getRows() <= 0 || m.getCols() <= 0;
+}
+
+bool SameShape(const S21Matrix &a, const S21Matrix &b) {
+  return a.getRows() == b.getRows() && a.getCols() == b.getCols();
+}
+
+// запись в разделённое хранилище потребовала бы Detach с выделением памяти
+bool Writable(const S21Matrix &out, int rows, int cols) {
+  return out.getRows() == rows && out.getCols() == cols && !out.IsShared();
+}
+
+// out может совпадать с a или b: элемент читается до записи
+template <typename Op>
+S21Status Elementwise(const S21Matrix &a, const S21Matrix &b, S21Matrix &out,
+                      Op op) {
+  if (IsEmpty(a) || IsEmpty(b)) return S21Status::kEmptyMatrix;
+  if (!SameShape(a, b)) return S21Status::kDimensionMismatch;
+  if (!Writable(out, a.getRows(), a.getCols())) {
+    return S21Status::kInvalidOutput;
+  }
+  double *const *pa = a.getMatrix();
+  double *const *pb = b.getMatrix();
+  double *const *po = out.getMatrix();
+  for (int i = 0; i < a.getRows(); ++i) {
+    for (int j = 0; j < a.getCols(); ++j) po[i][j] = op(pa[i][j], pb[i][j]);
+  }
+  return S21Status::kOk;
+}
+
+// work - отдельная матрица n x n, не разделённая с a
+S21Status CheckSquareWork(const S21Matrix &a, const S21Matrix &work) {
+  if (IsEmpty(a)) return S21Status::kEmptyMatrix;
+  if (a.getRows() != a.getCols()) return S21Status::kNotSquare;
+  if (&work == &a || !Writable(work, a.getRows(), a.getCols())) {
+    return S21Status::kInvalidOutput;
+  }
+  return S21Status::kOk;
+}
+
+void CopyRows(const S21Matrix &src, S21Matrix &dst) {
+  double *const *from = src.getMatrix();
+  double *const *to = dst.getMatrix();
+  for (int i = 0; i < src.getRows(); ++i) {
+    std::copy(from[i], from[i] + src.getCols(), to[i]);
+  }
+}
+
+// строка с наибольшим |m[i][k]| среди i >= k
+int PivotRow(double *const *m, int n, int k) {
+  int pivot = k;
+  double best = std::fabs(m[k][k]);
+  for (int i = k + 1; i < n; ++i) {
+    if (std::fabs(m[i][k]) > best) {
+      best = std::fabs(m[i][k]);
+      pivot = i;
+    }
+  }
+  return pivot;
+}
+}  // namespace
+
+const char *S21StatusMessage(S21Status status) noexcept {
+  switch (status) {
+    case S21Status::kOk:
+      return "Success.";
+    case S21Status::kEmptyMatrix:
+      return "Matrices must have positive dimensions.";
+    case S21Status::kDimensionMismatch:
+      return "Matrix dimensions are incompatible with the operation.";
+    case S21Status::kNotSquare:
+      return "Matrix must be square.";
+    case S21Status::kInvalidOutput:
+      return "Output matrix has wrong dimensions or overlaps an argument.";
+    case S21Status::kSingular:
+      return "Matrix is singular and cannot be inverted.";
+  }
+  return "Unknown status.";
+}
+
+S21Status S21TrySum(const S21Matrix &a, const S21Matrix &b,
+                    S21Matrix &out) noexcept {
+  return Elementwise(a, b, out, [](double x, double y) { return x + y; });
+}
+
+S21Status S21TrySub(const S21Matrix &a, const S21Matrix &b,
+                    S21Matrix &out) noexcept {
+  return Elementwise(a, b, out, [](double x, double y) { return x - y; });
+}
+
+S21Status S21TryMulNumber(const S21Matrix &a, double num,
+                          S21Matrix &out) noexcept {
+  return Elementwise(a, a, out, [num](double x, double) { return x * num; });
+}
+
+S21Status S21TryMultiply(const S21Matrix &a, const S21Matrix &b,
+                         S21Matrix &out) noexcept {
+  if (IsEmpty(a) || IsEmpty(b)) return S21Status::kEmptyMatrix;
+  if (a.getCols() != b.getRows()) return S21Status::kDimensionMismatch;
+  if (&out == &a || &out == &b ||
+      !Writable(out, a.getRows(), b.getCols())) {
+    return S21Status::kInvalidOutput;
+  }
+  double *const *pa = a.getMatrix();
+  double *const *pb = b.getMatrix();
+  double *const *po = out.getMatrix();
+  const int n = b.getCols();
+  for (int i = 0; i < a.getRows(); ++i) {
+    double *row = po[i];
+    std::fill(row, row + n, 0.0);
+    for (int k = 0; k < a.getCols(); ++k) {
+      const double a_ik = pa[i][k];
+      const double *b_row = pb[k];
+      for (int j = 0; j < n; ++j) row[j] += a_ik * b_row[j];
+    }
+  }
+  return S21Status::kOk;
+}
+
+S21Status S21TryDeterminant(const S21Matrix &a, S21Matrix &work,
+                            double &det) noexcept {
+  S21Status status = CheckSquareWork(a, work);
+  if (status != S21Status::kOk) return status;
+  CopyRows(a, work);
+  double *const *m = work.getMatrix();
+  const int n = a.getRows();
+  double result = 1.0;
+  for (int k = 0; k < n; ++k) {
+    int pivot = PivotRow(m, n, k);
+    if (m[pivot][k] == 0.0) {
+      det = 0.0;
+      return S21Status::kOk;
+    }
+    if (pivot != k) {
+      std::swap_ranges(m[k] + k, m[k] + n, m[pivot] + k);
+      result = -result;
+    }
+    result *= m[k][k];
+    for (int i = k + 1; i < n; ++i) {
+      const double l = m[i][k] / m[k][k];
+      for (int j = k + 1; j < n; ++j) m[i][j] -= l * m[k][j];
+    }
+  }
+  det = result;
+  return S21Status::kOk;
+}
+
+S21Status S21TryInverse(const S21Matrix &a, S21Matrix &work,
+                        S21Matrix &out) noexcept {
+  S21Status status = CheckSquareWork(a, work);
+  if (status != S21Status::kOk) return status;
+  if (&out == &a || &out == &work ||
+      !Writable(out, a.getRows(), a.getCols())) {
+    return S21Status::kInvalidOutput;
+  }
+  CopyRows(a, work);
+  double *const *m = work.getMatrix();
+  double *const *inv = out.getMatrix();
+  const int n = a.getRows();
+  for (int i = 0; i < n; ++i) {
+    std::fill(inv[i], inv[i] + n, 0.0);
+    inv[i][i] = 1.0;
+  }
+  for (int k = 0; k < n; ++k) {
+    int pivot = PivotRow(m, n, k);
+    if (m[pivot][k] == 0.0 || !std::isfinite(m[pivot][k])) {
+      return S21Status::kSingular;
+    }
+    if (pivot != k) {
+      std::swap_ranges(m[k] + k, m[k] + n, m[pivot] + k);
+      std::swap_ranges(inv[k], inv[k] + n, inv[pivot]);
+    }
+    const double scale = 1.0 / m[k][k];
+    for (int j = k; j < n; ++j) m[k][j] *= scale;
+    for (int j = 0; j < n; ++j) inv[k][j] *= scale;
+    for (int i = 0; i < n; ++i) {
+      const double l = m[i][k];
+      if (i == k || l == 0.0) continue;
+      for (int j = k; j < n; ++j) m[i][j] -= l * m[k][j];
+      for (int j = 0; j < n; ++j) inv[i][j] -= l * inv[k][j];
+    }
+  }
+  return S21Status::kOk;
+}
@@ -0,0 +1,41 @@
+#ifndef S21_MATRIX_STATUS_H
+#define S21_MATRIX_STATUS_H
+
+#include "s21_matrix_oop.h"
+
+// Варианты операций без исключений и без выделения памяти для участков,
+// где размеры проверяются заранее. Результат пишется в матрицу out нужного
+// размера, созданную вызывающим; при ошибке проверки размеров out не
+// меняется. out не может делить с кем-то хранилище (копирование при
+// записи) - отделение копии выделяло бы память. Поэлементные операции
+// допускают out, совпадающий с аргументом.
+enum class S21Status {
+  kOk,
+  kEmptyMatrix,        // у аргумента нулевое число строк или столбцов
+  kDimensionMismatch,  // размеры аргументов не подходят для операции
+  kNotSquare,
+  kInvalidOutput,  // неверный размер out или work, пересечение с аргументом
+  kSingular
+};
+
+const char *S21StatusMessage(S21Status status) noexcept;
+
+S21Status S21TrySum(const S21Matrix &a, const S21Matrix &b,
+                    S21Matrix &out) noexcept;
+S21Status S21TrySub(const S21Matrix &a, const S21Matrix &b,
+                    S21Matrix &out) noexcept;
+S21Status S21TryMulNumber(const S21Matrix &a, double num,
+                          S21Matrix &out) noexcept;
+// в одном потоке, без упаковки блоков
+S21Status S21TryMultiply(const S21Matrix &a, const S21Matrix &b,
+                         S21Matrix &out) noexcept;
+// LU-разложение в work размера n x n, содержимое work затирается
+S21Status S21TryDeterminant(const S21Matrix &a, S21Matrix &work,
+                            double &det) noexcept;
+// Гаусс-Жордан с выбором ведущего элемента, work - рабочая копия a.
+// kSingular только для нулевого или нечислового ведущего элемента,
+// плохая обусловленность не проверяется (в отличие от InverseMatrix).
+S21Status S21TryInverse(const S21Matrix &a, S21Matrix &work,
+                        S21Matrix &out) noexcept;
+
+#endif  // S21_MATRIX_STATUS_H
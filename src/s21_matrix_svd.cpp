@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+// строка считается линейно зависимой, если после ортогонализации от неё
+// осталась такая доля нормы
+const double kDependentRow = 1e-10;
+
+double RowDot(const double *x, const double *y, int n) {
+  double sum = 0.0;
+  for (int k = 0; k < n; ++k) sum += x[k] * y[k];
+  return sum;
+}
+
+void FillGaussian(double *row, int n, std::mt19937_64 &rng) {
+  std::normal_distribution<double> normal(0.0, 1.0);
+  for (int k = 0; k < n; ++k) row[k] = normal(rng);
+}
+
+// ортонормирование строк модифицированным Грамом-Шмидтом с повторным
+// проходом; зависимые строки заменяются случайными, чтобы базис оставался
+// полным
+void OrthonormalizeRows(S21Matrix &q, std::mt19937_64 &rng) {
+  const int l = q.getRows();
+  const int n = q.getCols();
+  double **rows = q.getMatrix();
+  for (int i = 0; i < l; ++i) {
+    double original = std::sqrt(RowDot(rows[i], rows[i], n));
+    for (int attempt = 0; attempt < 3; ++attempt) {
+      for (int pass = 0; pass < 2; ++pass) {
+        for (int j = 0; j < i; ++j) {
+          double proj = RowDot(rows[i], rows[j], n);
+          for (int k = 0; k < n; ++k) rows[i][k] -= proj * rows[j][k];
+        }
+      }
+      double norm = std::sqrt(RowDot(rows[i], rows[i], n));
+      if (norm > kDependentRow * original && norm > 0.0) {
+        for (int k = 0; k < n; ++k) rows[i][k] /= norm;
+        break;
+      }
+      FillGaussian(rows[i], n, rng);
+      original = std::sqrt(RowDot(rows[i], rows[i], n));
+    }
+  }
+}
+}  // namespace
+
+// Рандомизированное SVD (Halko, Martinsson, Tropp). Базис образа хранится
+// транспонированным (Q^T, l x m), чтобы ортогонализация шла по строкам.
+S21SvdResult S21Matrix::TruncatedSvd(int rank, int oversampling,
+                                     int power_iterations,
+                                     unsigned long long seed) const {
+  const int m = rows_;
+  const int n = cols_;
+  if (rank <= 0 || rank > std::min(m, n) || oversampling < 0 ||
+      power_iterations < 0) {
+    throw std::invalid_argument("Invalid truncated SVD parameters.");
+  }
+  const int l = std::min(rank + oversampling, std::min(m, n));
+  std::mt19937_64 rng(seed);
+
+  // Y^T = Omega^T * A^T
+  S21Matrix omega_t(l, n);
+  for (int i = 0; i < l; ++i) FillGaussian(omega_t.matrix_[i], n, rng);
+  S21Matrix q_t(l, m);
+  Gemm(1.0, omega_t, false, *this, true, 0.0, q_t);
+  OrthonormalizeRows(q_t, rng);
+
+  // степенные итерации сгущают спектр к старшим сингулярным числам
+  S21Matrix z_t(l, n);
+  for (int iter = 0; iter < power_iterations; ++iter) {
+    Gemm(1.0, q_t, false, *this, false, 0.0, z_t);
+    OrthonormalizeRows(z_t, rng);
+    Gemm(1.0, z_t, false, *this, true, 0.0, q_t);
+    OrthonormalizeRows(q_t, rng);
+  }
+
+  // B = Q^T * A (l x n), его SVD через собственное разложение B * B^T
+  S21Matrix b(l, n);
+  Gemm(1.0, q_t, false, *this, false, 0.0, b);
+  S21Matrix gram(l, l);
+  Gemm(1.0, b, false, b, true, 0.0, gram);
+  for (int i = 0; i < l; ++i) {
+    for (int j = 0; j < i; ++j) {
+      gram.matrix_[i][j] = gram.matrix_[j][i] =
+          0.5 * (gram.matrix_[i][j] + gram.matrix_[j][i]);
+    }
+  }
+  S21Matrix eigen_vectors;
+  std::vector<double> eigen_values = gram.EigenSymmetric(eigen_vectors);
+
+  // старшие rank собственных пар в порядке убывания
+  S21SvdResult result;
+  result.s.resize(rank);
+  S21Matrix u_b(l, rank);
+  for (int c = 0; c < rank; ++c) {
+    int source = l - 1 - c;
+    result.s[c] = std::sqrt(std::max(0.0, eigen_values[source]));
+    for (int r = 0; r < l; ++r) {
+      u_b.matrix_[r][c] = eigen_vectors.matrix_[r][source];
+    }
+  }
+  result.u = S21Matrix(m, rank);
+  Gemm(1.0, q_t, true, u_b, false, 0.0, result.u);
+  result.v = S21Matrix(n, rank);
+  Gemm(1.0, b, true, u_b, false, 0.0, result.v);
+  for (int c = 0; c < rank; ++c) {
+    double inverse = result.s[c] > 0.0 ? 1.0 / result.s[c] : 0.0;
+    for (int r = 0; r < n; ++r) result.v.matrix_[r][c] *= inverse;
+  }
+  return result;
+}
@@ -0,0 +1,188 @@
+#include "s21_numa.h"
+
+// привязка страниц и потоков есть только в Linux; на других системах
+// узел один, потоки не закрепляются, а буфер просто выравнивается
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "s21_executor.h"
+#include "s21_parallel.h"
+
+namespace {
+// буферы меньше этого заполняются вызывающим потоком
+const size_t kParallelBytes = size_t(2) << 20;
+// буферы от этого размера выравниваются по странице, чтобы политику
+// размещения можно было назначить только им
+const size_t kPageAlignBytes = size_t(1) << 16;
+const size_t kPageSize = 4096;
+const size_t kCacheLine = 64;
+
+std::atomic<S21NumaPolicy> numa_policy{S21NumaPolicy::kFirstTouch};
+std::atomic<int> numa_node{0};
+std::atomic<bool> thread_pinning{false};
+
+// "0-3,8-11" -> {0, 1, 2, 3, 8, 9, 10, 11}
+std::vector<int> ParseList(const std::string &text) {
+  std::vector<int> values;
+  std::stringstream stream(text);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || range == "\n") continue;
+    size_t dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last = dash == std::string::npos ? first
+                                         : std::stoi(range.substr(dash + 1));
+    for (int value = first; value <= last; ++value) values.push_back(value);
+  }
+  return values;
+}
+
+std::string ReadLine(const std::string &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+std::vector<int> OnlineNodes() {
+  std::vector<int> nodes =
+      ParseList(ReadLine("/sys/devices/system/node/online"));
+  if (nodes.empty()) nodes.push_back(0);
+  return nodes;
+}
+
+// ядра, доступные процессу, сгруппированные по узлам
+std::vector<int> CpusByNode() {
+#ifndef __linux__
+  return {};
+#else
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  sched_getaffinity(0, sizeof(allowed), &allowed);
+  std::vector<int> cpus;
+  for (int node : OnlineNodes()) {
+    std::string path =
+        "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+    for (int cpu : ParseList(ReadLine(path))) {
+      if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+    }
+  }
+  if (cpus.empty()) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+#endif
+}
+
+#ifdef __linux__
+// mbind без libnuma; ошибка не критична: страницы останутся по first-touch
+void BindPages(void *address, size_t bytes, S21NumaPolicy policy) {
+  std::vector<int> nodes = OnlineNodes();
+  unsigned long mask[16] = {};
+  const int kMaskBits = static_cast<int>(sizeof(mask) * 8);
+  int mode = MPOL_INTERLEAVE;
+  if (policy == S21NumaPolicy::kNode) {
+    mode = MPOL_BIND;
+    nodes.assign(1, numa_node.load());
+  }
+  for (int node : nodes) {
+    if (node >= 0 && node < kMaskBits) {
+      mask[node / (sizeof(long) * 8)] |= 1UL << (node % (sizeof(long) * 8));
+    }
+  }
+  syscall(SYS_mbind, address, bytes, mode, mask, kMaskBits + 1, 0);
+}
+#endif
+
+// заполнение строк [from, to): нулями или копией src
+void FillRows(double *buffer, const double *src, size_t cols, int from,
+              int to) {
+  size_t offset = static_cast<size_t>(from) * cols;
+  size_t count = static_cast<size_t>(to - from) * cols;
+  if (src != nullptr) {
+    std::memcpy(buffer + offset, src + offset, sizeof(double) * count);
+  } else {
+    std::memset(buffer + offset, 0, sizeof(double) * count);
+  }
+}
+}  // namespace
+
+void S21SetNumaPolicy(S21NumaPolicy policy, int node) {
+  if (policy == S21NumaPolicy::kNode) {
+    std::vector<int> nodes = OnlineNodes();
+    if (std::find(nodes.begin(), nodes.end(), node) == nodes.end()) {
+      throw std::invalid_argument("NUMA node is not online.");
+    }
+    numa_node.store(node);
+  }
+  numa_policy.store(policy);
+}
+
+S21NumaPolicy S21GetNumaPolicy() { return numa_policy.load(); }
+
+int S21NumaNodeCount() {
+  static const int count = static_cast<int>(OnlineNodes().size());
+  return count;
+}
+
+void S21SetThreadPinning(bool enabled) {
+  S21Executor::Instance().PinWorkers(enabled ? CpusByNode()
+                                             : std::vector<int>());
+  thread_pinning.store(enabled);
+}
+
+bool S21GetThreadPinning() { return thread_pinning.load(); }
+
+double *S21AllocateBuffer(int rows, int cols, const double *src) {
+  size_t count = static_cast<size_t>(rows) * cols;
+  size_t bytes = sizeof(double) * count;
+  size_t alignment = bytes >= kPageAlignBytes ? kPageSize : kCacheLine;
+  // страницы привязываются целиком, поэтому размер кратен выравниванию
+  size_t padded = (bytes + alignment - 1) / alignment * alignment;
+  void *memory = nullptr;
+  if (posix_memalign(&memory, alignment, std::max(padded, alignment)) != 0) {
+    throw std::bad_alloc();
+  }
+  double *buffer = static_cast<double *>(memory);
+
+  S21NumaPolicy policy = numa_policy.load();
+#ifdef __linux__
+  if (alignment == kPageSize && (policy == S21NumaPolicy::kInterleave ||
+                                 policy == S21NumaPolicy::kNode)) {
+    BindPages(buffer, padded, policy);
+  }
+#endif
+  // с одним узлом размещать нечего, и заполнение в пуле только задержало
+  // бы вызывающего; условие то же, что в S21GemmKernel
+  if (policy != S21NumaPolicy::kFirstTouch || S21NumaNodeCount() <= 1 ||
+      bytes < kParallelBytes) {
+    FillRows(buffer, src, cols, 0, rows);
+  } else {
+    // те же куски строк, что получат потоки в S21ParallelForStatic
+    S21ParallelForStatic(0, rows, [buffer, src, cols](int from, int to) {
+      FillRows(buffer, src, cols, from, to);
+    });
+  }
+  return buffer;
+}
+
+void S21FreeBuffer(double *buffer) { std::free(buffer); }
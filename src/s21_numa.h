@@ -0,0 +1,33 @@
+#ifndef S21_NUMA_H
+#define S21_NUMA_H
+
+#include <cstddef>
+
+// Размещение буферов матриц на многосокетных машинах. Linux отдаёт
+// физическую страницу узлу, чей поток первым к ней обратился, поэтому
+// буферы заполняются теми же потоками и с тем же статическим разбиением
+// по строкам, что и параллельные ядра.
+enum class S21NumaPolicy {
+  kAllocatingThread,  // заполнение вызывающим потоком (прежнее поведение)
+  kFirstTouch,        // заполнение потоками пула по строкам (узлов > 1)
+  kInterleave,        // страницы чередуются по всем узлам
+  kNode               // все страницы на заданном узле
+};
+
+void S21SetNumaPolicy(S21NumaPolicy policy, int node = 0);
+S21NumaPolicy S21GetNumaPolicy();
+// число узлов NUMA, 1 на машинах без NUMA
+int S21NumaNodeCount();
+
+// Закрепление рабочих потоков за ядрами в порядке обхода узлов. Привязка
+// страниц и потоков работает только в Linux, на других системах узел
+// считается одним, а закрепление ничего не делает.
+void S21SetThreadPinning(bool enabled);
+bool S21GetThreadPinning();
+
+// Буфер rows * cols элементов, заполненный нулями или копией src,
+// размещённый по текущей политике. Освобождается S21FreeBuffer.
+double *S21AllocateBuffer(int rows, int cols, const double *src = nullptr);
+void S21FreeBuffer(double *buffer);
+
+#endif  // S21_NUMA_H
@@ -0,0 +1,87 @@
+#include "s21_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "s21_executor.h"
+
+namespace {
+int DefaultThreadCount() {
+  unsigned hw = std::thread::hardware_concurrency();
+  return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+std::atomic<int> thread_count{DefaultThreadCount()};
+
+// рекурсивное деление пополам: половины уходят в очередь текущего потока
+// и перехватываются простаивающими потоками
+void SplitRange(S21TaskGroup &group, int begin, int end, int grain,
+                const std::function<void(int, int)> &body) {
+  while (end - begin > grain) {
+    int middle = begin + (end - begin) / 2;
+    group.Run([&group, middle, end, grain, &body]() {
+      SplitRange(group, middle, end, grain, body);
+    });
+    end = middle;
+  }
+  body(begin, end);
+}
+}  // namespace
+
+int S21GetThreadCount() { return thread_count.load(); }
+
+void S21SetThreadCount(int count) {
+  if (count <= 0) {
+    throw std::invalid_argument("Thread count must be a positive integer.");
+  }
+  thread_count.store(count);
+  S21Executor::Instance().EnsureWorkers(count);
+}
+
+void S21ParallelFor(int begin, int end, int grain,
+                    const std::function<void(int, int)> &body) {
+  if (end <= begin) return;
+  grain = std::max(grain, 1);
+  if (S21GetThreadCount() <= 1 || end - begin <= grain) {
+    body(begin, end);
+    return;
+  }
+  S21TaskGroup group;
+  // исключение из куска не должно оставить группу с живыми задачами
+  try {
+    SplitRange(group, begin, end, grain, body);
+  } catch (...) {
+    group.Wait();
+    throw;
+  }
+  group.Wait();
+}
+
+void S21ParallelForStatic(int begin, int end,
+                          const std::function<void(int, int)> &body) {
+  if (end <= begin) return;
+  S21Executor &executor = S21Executor::Instance();
+  int pieces = std::min({S21GetThreadCount(), executor.getWorkerCount(),
+                         end - begin});
+  if (pieces <= 1) {
+    body(begin, end);
+    return;
+  }
+  long long length = end - begin;
+  // внутри задачи пула закреплённый кусок может ждать поток, который сам
+  // заблокирован в ожидании, поэтому здесь куски раздаются с перехватом
+  if (S21Executor::CurrentWorker() >= 0) {
+    S21ParallelFor(begin, end, static_cast<int>((length + pieces - 1) / pieces),
+                   body);
+    return;
+  }
+  S21TaskGroup group;
+  for (int piece = 0; piece < pieces; ++piece) {
+    int from = begin + static_cast<int>(length * piece / pieces);
+    int to = begin + static_cast<int>(length * (piece + 1) / pieces);
+    group.RunOn(piece, [from, to, &body]() { body(from, to); });
+  }
+  group.Wait();
+}
@@ -0,0 +1,22 @@
+#ifndef S21_PARALLEL_H
+#define S21_PARALLEL_H
+
+#include <functional>
+
+// Количество потоков, используемых параллельными ядрами библиотеки
+int S21GetThreadCount();
+void S21SetThreadCount(int count);
+
+// Делит диапазон [begin, end) на куски не меньше grain и выполняет
+// body(from, to) для каждого куска в отдельном потоке
+void S21ParallelFor(int begin, int end, int grain,
+                    const std::function<void(int, int)> &body);
+
+// Статическое разбиение: [begin, end) делится на равные куски по числу
+// потоков, кусок w всегда выполняет рабочий поток w. Повторные вызовы с тем
+// же диапазоном обращаются к одним и тем же строкам из одних и тех же
+// потоков, что сохраняет локальность first-touch размещения
+void S21ParallelForStatic(int begin, int end,
+                          const std::function<void(int, int)> &body);
+
+#endif  // S21_PARALLEL_H
@@ -0,0 +1,148 @@
+#include "s21_result_cache.h"
+
+#include <cstring>
+
+namespace {
+const uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+const uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+const int kLanes = 4;
+
+uint64_t Rotate(uint64_t value, int shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+uint64_t Round(uint64_t acc, uint64_t word) {
+  return Rotate(acc + word * kPrime2, 31) * kPrime1;
+}
+
+uint64_t Mix(uint64_t value) {
+  value ^= value >> 33;
+  value *= kPrime2;
+  value ^= value >> 29;
+  value *= kPrime1;
+  return value ^ (value >> 32);
+}
+
+// Совпадение хеша подтверждается побитово: EqMatrix сравнивает с допуском
+// и считает NaN равным чему угодно, а коллизия не должна вернуть
+// результат для другой матрицы
+bool SameBits(const S21Matrix &a, const S21Matrix &b) {
+  if (a.getRows() != b.getRows() || a.getCols() != b.getCols()) return false;
+  const size_t size = static_cast<size_t>(a.getRows()) * a.getCols();
+  return size == 0 || std::memcmp(a.getMatrix()[0], b.getMatrix()[0],
+                                  size * sizeof(double)) == 0;
+}
+}  // namespace
+
+S21ResultCache &S21ResultCache::Instance() {
+  static S21ResultCache cache;
+  return cache;
+}
+
+void S21ResultCache::SetCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_.store(capacity);
+  EvictOverflow();
+}
+
+bool S21ResultCache::Enabled() const { return capacity_.load() > 0; }
+
+S21CacheStats S21ResultCache::Stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {hits_, misses_, evictions_, entries_.size(), capacity_.load()};
+}
+
+void S21ResultCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  hits_ = 0;
+  misses_ = 0;
+  evictions_ = 0;
+}
+
+// Четыре независимые дорожки по словам данных (как в xxHash) компилятор
+// векторизует; размеры входят в начальное состояние
+uint64_t S21ResultCache::Hash(const S21Matrix &matrix) {
+  const size_t size =
+      static_cast<size_t>(matrix.getRows()) * matrix.getCols();
+  const double *data = matrix.getMatrix()[0];
+  uint64_t lanes[kLanes] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+  lanes[2] ^= static_cast<uint64_t>(matrix.getRows());
+  lanes[3] ^= static_cast<uint64_t>(matrix.getCols()) << 32;
+  size_t k = 0;
+  for (; k + kLanes <= size; k += kLanes) {
+    uint64_t words[kLanes];
+    std::memcpy(words, data + k, sizeof(words));
+    for (int lane = 0; lane < kLanes; ++lane) {
+      lanes[lane] = Round(lanes[lane], words[lane]);
+    }
+  }
+  for (int lane = 0; k < size; ++k, ++lane) {
+    uint64_t word;
+    std::memcpy(&word, data + k, sizeof(word));
+    lanes[lane] = Round(lanes[lane], word);
+  }
+  uint64_t hash = Rotate(lanes[0], 1) + Rotate(lanes[1], 7) +
+                  Rotate(lanes[2], 12) + Rotate(lanes[3], 18);
+  return Mix(hash + size);
+}
+
+S21ResultCache::EntryList::iterator S21ResultCache::Lookup(
+    S21CachedOp op, const S21Matrix &key, uint64_t hash) {
+  auto range = index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Entry &entry = *it->second;
+    if (entry.op == op && SameBits(entry.key, key)) return it->second;
+  }
+  return entries_.end();
+}
+
+bool S21ResultCache::Find(S21CachedOp op, const S21Matrix &key,
+                          uint64_t hash, S21Matrix &result) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EntryList::iterator entry = Lookup(op, key, hash);
+  if (entry == entries_.end()) {
+    ++misses_;
+    return false;
+  }
+  ++hits_;
+  entries_.splice(entries_.begin(), entries_, entry);
+  result = entry->result;
+  return true;
+}
+
+void S21ResultCache::Insert(S21CachedOp op, const S21Matrix &key,
+                            uint64_t hash, const S21Matrix &result) {
+  // копии делаются вне блокировки
+  Entry entry{op, hash, key, result};
+  entry.key.Detach();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_.load() == 0) return;
+  // тот же вход мог успеть вставить другой поток
+  EntryList::iterator existing = Lookup(op, key, hash);
+  if (existing != entries_.end()) {
+    entries_.splice(entries_.begin(), entries_, existing);
+    return;
+  }
+  entries_.push_front(std::move(entry));
+  index_.emplace(hash, entries_.begin());
+  EvictOverflow();
+}
+
+// вызывается под mutex_
+void S21ResultCache::EvictOverflow() {
+  size_t capacity = capacity_.load();
+  while (entries_.size() > capacity) {
+    const Entry &last = entries_.back();
+    auto range = index_.equal_range(last.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == std::prev(entries_.end())) {
+        index_.erase(it);
+        break;
+      }
+    }
+    entries_.pop_back();
+    ++evictions_;
+  }
+}
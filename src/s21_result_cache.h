@@ -0,0 +1,88 @@
+#ifndef S21_RESULT_CACHE_H
+#define S21_RESULT_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "s21_matrix_oop.h"
+
+// операции, результаты которых кешируются
+enum class S21CachedOp { kInverse, kDeterminant, kComplements };
+
+struct S21CacheStats {
+  size_t hits;
+  size_t misses;
+  size_t evictions;
+  size_t size;
+  size_t capacity;
+};
+
+// Ограниченный LRU-кеш результатов InverseMatrix, Determinant и
+// CalcComplements для повторяющихся входных матриц. Ключ - хеш размеров
+// и данных, совпадение подтверждается побитовым сравнением с сохранённой
+// копией входа (EqMatrix с допуском вернул бы результат для другой матрицы).
+// По умолчанию выключен (ёмкость 0).
+class S21ResultCache {
+ public:
+  static S21ResultCache &Instance();
+
+  S21ResultCache(const S21ResultCache &) = delete;
+  S21ResultCache &operator=(const S21ResultCache &) = delete;
+
+  // число хранимых результатов, 0 выключает кеш и очищает его
+  void SetCapacity(size_t capacity);
+  bool Enabled() const;
+  S21CacheStats Stats() const;
+  // удаляет записи и обнуляет статистику
+  void Clear();
+
+  static uint64_t Hash(const S21Matrix &matrix);
+  bool Find(S21CachedOp op, const S21Matrix &key, uint64_t hash,
+            S21Matrix &result);
+  void Insert(S21CachedOp op, const S21Matrix &key, uint64_t hash,
+              const S21Matrix &result);
+
+ private:
+  struct Entry {
+    S21CachedOp op;
+    uint64_t hash;
+    S21Matrix key;
+    S21Matrix result;
+  };
+  using EntryList = std::list<Entry>;
+
+  S21ResultCache() = default;
+  // запись с тем же входом, end() если её нет; вызывается под mutex_
+  EntryList::iterator Lookup(S21CachedOp op, const S21Matrix &key,
+                             uint64_t hash);
+  void EvictOverflow();
+
+  mutable std::mutex mutex_;
+  std::atomic<size_t> capacity_{0};
+  // начало списка - последние использованные записи
+  EntryList entries_;
+  std::unordered_multimap<uint64_t, EntryList::iterator> index_;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+  size_t evictions_ = 0;
+};
+
+// результат compute() через кеш, если он включён
+template <typename Compute>
+S21Matrix S21CachedResult(S21CachedOp op, const S21Matrix &key,
+                          Compute compute) {
+  S21ResultCache &cache = S21ResultCache::Instance();
+  if (!cache.Enabled()) return compute();
+  uint64_t hash = S21ResultCache::Hash(key);
+  S21Matrix result;
+  if (cache.Find(op, key, hash, result)) return result;
+  result = compute();
+  cache.Insert(op, key, hash, result);
+  return result;
+}
+
+#endif  // S21_RESULT_CACHE_H
@@ -0,0 +1,390 @@
+#include "s21_structured_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "s21_parallel.h"
+
+namespace {
+// строк или столбцов результата на одну задачу пула
+const int kStructuredGrain = 32;
+
+void CheckSize(int size) {
+  if (size <= 0) {
+    throw std::invalid_argument("Matrix size must be a positive integer.");
+  }
+}
+
+void CheckSquare(const S21Matrix &full) {
+  if (full.getRows() != full.getCols()) {
+    throw std::invalid_argument("Matrix must be square.");
+  }
+}
+
+void CheckOperand(int size, const S21Matrix &b) {
+  if (b.getRows() != size) {
+    throw std::invalid_argument(
+        "Matrices cannot be multiplied: incompatible dimensions.");
+  }
+}
+}  // namespace
+
+// симметричная матрица
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size) {
+  CheckSize(size);
+  data_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix &full)
+    : S21SymmetricMatrix(full.getRows()) {
+  CheckSquare(full);
+  double **a = full.getMatrix();
+  for (int i = 0; i < size_; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      if (std::fabs(a[i][j] - a[j][i]) > 1e-7) {
+        throw std::invalid_argument("Matrix is not symmetric.");
+      }
+      data_[Index(i, j)] = a[i][j];
+    }
+  }
+}
+
+size_t S21SymmetricMatrix::Index(int i, int j) const {
+  if (i >= size_ || j >= size_ || i < 0 || j < 0) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  if (i < j) std::swap(i, j);
+  return static_cast<size_t>(i) * (i + 1) / 2 + j;
+}
+
+double &S21SymmetricMatrix::operator()(int i, int j) {
+  return data_[Index(i, j)];
+}
+
+double S21SymmetricMatrix::operator()(int i, int j) const {
+  return data_[Index(i, j)];
+}
+
+S21Matrix S21SymmetricMatrix::ToMatrix() const {
+  S21Matrix full(size_, size_);
+  double **a = full.getMatrix();
+  for (int i = 0; i < size_; ++i) {
+    const double *packed = &data_[Index(i, 0)];
+    for (int j = 0; j <= i; ++j) a[i][j] = a[j][i] = packed[j];
+  }
+  return full;
+}
+
+// каждый упакованный элемент читается один раз и используется для двух
+// строк результата; потоки делят между собой столбцы B
+S21Matrix S21SymmetricMatrix::Multiply(const S21Matrix &b) const {
+  CheckOperand(size_, b);
+  const int cols = b.getCols();
+  S21Matrix result(size_, cols);
+  double **src = b.getMatrix();
+  double **dst = result.getMatrix();
+  S21ParallelFor(0, cols, kStructuredGrain, [&](int from, int to) {
+    for (int i = 0; i < size_; ++i) {
+      const double *packed = &data_[Index(i, 0)];
+      for (int j = 0; j < i; ++j) {
+        const double a_ij = packed[j];
+        for (int c = from; c < to; ++c) {
+          dst[i][c] += a_ij * src[j][c];
+          dst[j][c] += a_ij * src[i][c];
+        }
+      }
+      const double a_ii = packed[i];
+      for (int c = from; c < to; ++c) dst[i][c] += a_ii * src[i][c];
+    }
+  });
+  return result;
+}
+
+// треугольная матрица
+S21TriangularMatrix::S21TriangularMatrix(int size, S21Triangle triangle)
+    : size_(size), triangle_(triangle) {
+  CheckSize(size);
+  data_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+S21TriangularMatrix::S21TriangularMatrix(const S21Matrix &full,
+                                         S21Triangle triangle)
+    : S21TriangularMatrix(full.getRows(), triangle) {
+  CheckSquare(full);
+  double **a = full.getMatrix();
+  for (int i = 0; i < size_; ++i) {
+    for (int j = 0; j < size_; ++j) {
+      if (InTriangle(i, j)) data_[Index(i, j)] = a[i][j];
+    }
+  }
+}
+
+bool S21TriangularMatrix::InTriangle(int i, int j) const {
+  return triangle_ == S21Triangle::kLower ? j <= i : j >= i;
+}
+
+// нижний треугольник: строка i начинается с i(i+1)/2,
+// верхний: строка i начинается с i*n - i(i-1)/2 и идёт от диагонали
+size_t S21TriangularMatrix::Index(int i, int j) const {
+  size_t row = static_cast<size_t>(i);
+  if (triangle_ == S21Triangle::kLower) return row * (row + 1) / 2 + j;
+  return row * size_ - row * (row - 1) / 2 + (j - i);
+}
+
+double &S21TriangularMatrix::operator()(int i, int j) {
+  if (i >= size_ || j >= size_ || i < 0 || j < 0 || !InTriangle(i, j)) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  return data_[Index(i, j)];
+}
+
+double S21TriangularMatrix::operator()(int i, int j) const {
+  if (i >= size_ || j >= size_ || i < 0 || j < 0) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  return InTriangle(i, j) ? data_[Index(i, j)] : 0.0;
+}
+
+S21Matrix S21TriangularMatrix::ToMatrix() const {
+  S21Matrix full(size_, size_);
+  double **a = full.getMatrix();
+  for (int i = 0; i < size_; ++i) {
+    int from = triangle_ == S21Triangle::kLower ? 0 : i;
+    int to = triangle_ == S21Triangle::kLower ? i + 1 : size_;
+    const double *packed = &data_[Index(i, from)];
+    std::copy(packed, packed + (to - from), a[i] + from);
+  }
+  return full;
+}
+
+S21Matrix S21TriangularMatrix::Multiply(const S21Matrix &b) const {
+  CheckOperand(size_, b);
+  const int cols = b.getCols();
+  S21Matrix result(size_, cols);
+  double **src = b.getMatrix();
+  double **dst = result.getMatrix();
+  S21ParallelFor(0, size_, kStructuredGrain, [&](int row_begin, int row_end) {
+    for (int i = row_begin; i < row_end; ++i) {
+      int from = triangle_ == S21Triangle::kLower ? 0 : i;
+      int to = triangle_ == S21Triangle::kLower ? i + 1 : size_;
+      const double *packed = &data_[Index(i, from)];
+      for (int k = from; k < to; ++k) {
+        const double t_ik = packed[k - from];
+        for (int c = 0; c < cols; ++c) dst[i][c] += t_ik * src[k][c];
+      }
+    }
+  });
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix &b) const {
+  CheckOperand(size_, b);
+  // произведение диагонали может обнулиться при обычной матрице, поэтому
+  // каждый диагональный элемент проверяется отдельно
+  for (int i = 0; i < size_; ++i) {
+    if (data_[Index(i, i)] == 0.0) {
+      throw std::invalid_argument(
+          "Matrix is singular, system cannot be solved.");
+    }
+  }
+  const int cols = b.getCols();
+  S21Matrix x(b);
+  x.Detach();
+  double **dst = x.getMatrix();
+  const bool lower = triangle_ == S21Triangle::kLower;
+  for (int step = 0; step < size_; ++step) {
+    int i = lower ? step : size_ - 1 - step;
+    int from = lower ? 0 : i + 1;
+    int to = lower ? i : size_;
+    for (int k = from; k < to; ++k) {
+      const double t_ik = data_[Index(i, k)];
+      for (int c = 0; c < cols; ++c) dst[i][c] -= t_ik * dst[k][c];
+    }
+    const double diag = data_[Index(i, i)];
+    for (int c = 0; c < cols; ++c) dst[i][c] /= diag;
+  }
+  return x;
+}
+
+double S21TriangularMatrix::Determinant() const {
+  double det = 1.0;
+  for (int i = 0; i < size_; ++i) det *= data_[Index(i, i)];
+  return det;
+}
+
+// ленточная матрица
+struct S21BandMatrix::Factor {
+  // строка i хранит столбцы [i - lower, i + lower + upper]: при
+  // перестановках строк лента U расширяется на lower
+  int width = 0;
+  std::vector<double> work;
+  std::vector<double> multipliers;
+  std::vector<int> pivots;
+  int sign = 1;
+
+  double &At(int lower, int i, int j) {
+    return work[static_cast<size_t>(i) * width + (j - i + lower)];
+  }
+};
+
+S21BandMatrix::S21BandMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  CheckSize(size);
+  if (lower < 0 || upper < 0) {
+    throw std::invalid_argument("Bandwidths must be non-negative integers.");
+  }
+  data_.assign(static_cast<size_t>(size) * (lower + upper + 1), 0.0);
+}
+
+S21BandMatrix::S21BandMatrix(const S21Matrix &full, int lower, int upper)
+    : S21BandMatrix(full.getRows(), lower, upper) {
+  CheckSquare(full);
+  double **a = full.getMatrix();
+  for (int i = 0; i < size_; ++i) {
+    int from = std::max(0, i - lower_);
+    int to = std::min(size_ - 1, i + upper_);
+    for (int j = from; j <= to; ++j) (*this)(i, j) = a[i][j];
+  }
+}
+
+bool S21BandMatrix::InBand(int i, int j) const {
+  return j >= i - lower_ && j <= i + upper_;
+}
+
+double &S21BandMatrix::operator()(int i, int j) {
+  if (i >= size_ || j >= size_ || i < 0 || j < 0 || !InBand(i, j)) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  return data_[static_cast<size_t>(i) * (lower_ + upper_ + 1) +
+               (j - i + lower_)];
+}
+
+double S21BandMatrix::operator()(int i, int j) const {
+  if (i >= size_ || j >= size_ || i < 0 || j < 0) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  if (!InBand(i, j)) return 0.0;
+  return data_[static_cast<size_t>(i) * (lower_ + upper_ + 1) +
+               (j - i + lower_)];
+}
+
+S21Matrix S21BandMatrix::ToMatrix() const {
+  S21Matrix full(size_, size_);
+  double **a = full.getMatrix();
+  for (int i = 0; i < size_; ++i) {
+    int from = std::max(0, i - lower_);
+    int to = std::min(size_ - 1, i + upper_);
+    for (int j = from; j <= to; ++j) a[i][j] = (*this)(i, j);
+  }
+  return full;
+}
+
+S21Matrix S21BandMatrix::Multiply(const S21Matrix &b) const {
+  CheckOperand(size_, b);
+  const int cols = b.getCols();
+  const int width = lower_ + upper_ + 1;
+  S21Matrix result(size_, cols);
+  double **src = b.getMatrix();
+  double **dst = result.getMatrix();
+  S21ParallelFor(0, size_, kStructuredGrain, [&](int row_begin, int row_end) {
+    for (int i = row_begin; i < row_end; ++i) {
+      int from = std::max(0, i - lower_);
+      int to = std::min(size_ - 1, i + upper_);
+      const double *band = &data_[static_cast<size_t>(i) * width];
+      for (int k = from; k <= to; ++k) {
+        const double a_ik = band[k - i + lower_];
+        for (int c = 0; c < cols; ++c) dst[i][c] += a_ik * src[k][c];
+      }
+    }
+  });
+  return result;
+}
+
+// ленточный аналог dgbfa из LINPACK
+bool S21BandMatrix::Factorize(Factor &factor) const {
+  const int n = size_;
+  const int span = lower_ + upper_;
+  factor.width = 2 * lower_ + upper_ + 1;
+  factor.work.assign(static_cast<size_t>(n) * factor.width, 0.0);
+  factor.multipliers.assign(static_cast<size_t>(n) * lower_, 0.0);
+  factor.pivots.assign(n, 0);
+  factor.sign = 1;
+  for (int i = 0; i < n; ++i) {
+    int from = std::max(0, i - lower_);
+    int to = std::min(n - 1, i + upper_);
+    for (int j = from; j <= to; ++j) factor.At(lower_, i, j) = (*this)(i, j);
+  }
+  for (int k = 0; k < n; ++k) {
+    int last_row = std::min(n - 1, k + lower_);
+    int last_col = std::min(n - 1, k + span);
+    int pivot = k;
+    double best = std::fabs(factor.At(lower_, k, k));
+    for (int i = k + 1; i <= last_row; ++i) {
+      double value = std::fabs(factor.At(lower_, i, k));
+      if (value > best) {
+        best = value;
+        pivot = i;
+      }
+    }
+    factor.pivots[k] = pivot;
+    if (best == 0.0) return false;
+    if (pivot != k) {
+      for (int j = k; j <= last_col; ++j) {
+        std::swap(factor.At(lower_, k, j), factor.At(lower_, pivot, j));
+      }
+      factor.sign = -factor.sign;
+    }
+    const double diag = factor.At(lower_, k, k);
+    for (int i = k + 1; i <= last_row; ++i) {
+      double l = factor.At(lower_, i, k) / diag;
+      factor.multipliers[static_cast<size_t>(k) * lower_ + (i - k - 1)] = l;
+      factor.At(lower_, i, k) = 0.0;
+      for (int j = k + 1; j <= last_col; ++j) {
+        factor.At(lower_, i, j) -= l * factor.At(lower_, k, j);
+      }
+    }
+  }
+  return true;
+}
+
+S21Matrix S21BandMatrix::Solve(const S21Matrix &b) const {
+  CheckOperand(size_, b);
+  Factor factor;
+  if (!Factorize(factor)) {
+    throw std::invalid_argument("Matrix is singular, system cannot be solved.");
+  }
+  const int n = size_;
+  const int cols = b.getCols();
+  S21Matrix x(b);
+  x.Detach();
+  double **dst = x.getMatrix();
+  for (int k = 0; k < n; ++k) {
+    if (factor.pivots[k] != k) {
+      std::swap_ranges(dst[k], dst[k] + cols, dst[factor.pivots[k]]);
+    }
+    int last_row = std::min(n - 1, k + lower_);
+    for (int i = k + 1; i <= last_row; ++i) {
+      double l =
+          factor.multipliers[static_cast<size_t>(k) * lower_ + (i - k - 1)];
+      for (int c = 0; c < cols; ++c) dst[i][c] -= l * dst[k][c];
+    }
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    int last_col = std::min(n - 1, i + lower_ + upper_);
+    for (int j = i + 1; j <= last_col; ++j) {
+      double u = factor.At(lower_, i, j);
+      for (int c = 0; c < cols; ++c) dst[i][c] -= u * dst[j][c];
+    }
+    double diag = factor.At(lower_, i, i);
+    for (int c = 0; c < cols; ++c) dst[i][c] /= diag;
+  }
+  return x;
+}
+
+double S21BandMatrix::Determinant() const {
+  Factor factor;
+  if (!Factorize(factor)) return 0.0;
+  double det = factor.sign;
+  for (int i = 0; i < size_; ++i) det *= factor.At(lower_, i, i);
+  return det;
+}
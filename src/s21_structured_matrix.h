@@ -0,0 +1,95 @@
+#ifndef S21_STRUCTURED_MATRIX_H
+#define S21_STRUCTURED_MATRIX_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Матрицы со структурой, которые хранят только значимую часть элементов.
+// Каждая преобразуется из S21Matrix и обратно (ToMatrix).
+
+// Симметричная матрица: упакованный нижний треугольник, n(n+1)/2 элементов
+class S21SymmetricMatrix {
+ public:
+  explicit S21SymmetricMatrix(int size);
+  // матрица должна быть симметричной с точностью EqMatrix
+  explicit S21SymmetricMatrix(const S21Matrix &full);
+
+  int getSize() const { return size_; }
+  double &operator()(int i, int j);
+  double operator()(int i, int j) const;
+
+  S21Matrix ToMatrix() const;
+  // SYMM: A * B
+  S21Matrix Multiply(const S21Matrix &b) const;
+
+ private:
+  size_t Index(int i, int j) const;
+
+  int size_;
+  std::vector<double> data_;
+};
+
+enum class S21Triangle { kLower, kUpper };
+
+// Треугольная матрица: упакованы только элементы треугольника
+class S21TriangularMatrix {
+ public:
+  S21TriangularMatrix(int size, S21Triangle triangle);
+  // берётся указанный треугольник, остальные элементы отбрасываются
+  S21TriangularMatrix(const S21Matrix &full, S21Triangle triangle);
+
+  int getSize() const { return size_; }
+  S21Triangle getTriangle() const { return triangle_; }
+  double &operator()(int i, int j);
+  double operator()(int i, int j) const;
+
+  S21Matrix ToMatrix() const;
+  // TRMM: T * B
+  S21Matrix Multiply(const S21Matrix &b) const;
+  // TRSM: решение T * X = B подстановкой
+  S21Matrix Solve(const S21Matrix &b) const;
+  double Determinant() const;
+
+ private:
+  bool InTriangle(int i, int j) const;
+  size_t Index(int i, int j) const;
+
+  int size_;
+  S21Triangle triangle_;
+  std::vector<double> data_;
+};
+
+// Ленточная матрица с lower поддиагоналями и upper наддиагоналями.
+// Строка i хранит столбцы [i - lower, i + upper].
+class S21BandMatrix {
+ public:
+  S21BandMatrix(int size, int lower, int upper);
+  // элементы вне ленты отбрасываются
+  S21BandMatrix(const S21Matrix &full, int lower, int upper);
+
+  int getSize() const { return size_; }
+  int getLower() const { return lower_; }
+  int getUpper() const { return upper_; }
+  double &operator()(int i, int j);
+  double operator()(int i, int j) const;
+
+  S21Matrix ToMatrix() const;
+  // A * B за O(n * (lower + upper + 1) * cols)
+  S21Matrix Multiply(const S21Matrix &b) const;
+  // ленточное LU с выбором ведущего элемента за O(n * lower * (lower +
+  // upper))
+  S21Matrix Solve(const S21Matrix &b) const;
+  double Determinant() const;
+
+ private:
+  struct Factor;
+
+  bool InBand(int i, int j) const;
+  bool Factorize(Factor &factor) const;
+
+  int size_, lower_, upper_;
+  std::vector<double> data_;
+};
+
+#endif  // S21_STRUCTURED_MATRIX_H
@@ -0,0 +1,207 @@
+#include "s21_tiled_matrix.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_parallel.h"
+
+namespace {
+// меньшие произведения считаются в одном потоке
+const long long kParallelThreshold = 64LL * 64 * 64;
+
+// чередование битов строки и столбца плитки
+uint64_t MortonCode(uint32_t row, uint32_t col) {
+  uint64_t code = 0;
+  for (int bit = 0; bit < 32; ++bit) {
+    code |= static_cast<uint64_t>((col >> bit) & 1U) << (2 * bit);
+    code |= static_cast<uint64_t>((row >> bit) & 1U) << (2 * bit + 1);
+  }
+  return code;
+}
+
+// C += A * B для плиток tile x tile, из которых заняты rows x depth у A и
+// depth x cols у B; внутренний цикл идёт по строке B и строке C подряд и
+// векторизуется. Нулевые a_ik не пропускаются: 0 * NaN и 0 * Inf в B
+// должны попасть в C, как в S21Matrix::Multiply. Дополнение краёв не
+// читается и не пишется, иначе Inf * 0 оставил бы в нём NaN, который
+// следующее умножение перенесло бы в настоящие элементы.
+void MultiplyTile(int tile, int rows, int depth, int cols, const double *a,
+                  const double *b, double *c) {
+  for (int i = 0; i < rows; ++i) {
+    double *c_row = c + static_cast<size_t>(i) * tile;
+    for (int k = 0; k < depth; ++k) {
+      const double a_ik = a[static_cast<size_t>(i) * tile + k];
+      const double *b_row = b + static_cast<size_t>(k) * tile;
+      for (int j = 0; j < cols; ++j) c_row[j] += a_ik * b_row[j];
+    }
+  }
+}
+
+// занятая часть плитки номер block при размере size
+int TileExtent(int size, int tile, int block) {
+  return std::min(tile, size - block * tile);
+}
+}  // namespace
+
+S21TiledMatrix::S21TiledMatrix(int rows, int cols, int tile,
+                               S21TileOrder order)
+    : rows_(rows), cols_(cols), tile_(tile), order_(order) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument("Rows and columns must be positive integers");
+  }
+  if (tile <= 0) {
+    throw std::invalid_argument("Tile size must be a positive integer.");
+  }
+  block_rows_ = (rows + tile - 1) / tile;
+  block_cols_ = (cols + tile - 1) / tile;
+  BuildOffsets();
+  data_.assign(offsets_.size() * tile * tile, 0.0);
+}
+
+S21TiledMatrix::S21TiledMatrix(const S21Matrix &matrix, int tile,
+                               S21TileOrder order)
+    : S21TiledMatrix(matrix.getRows(), matrix.getCols(), tile, order) {
+  double **src = matrix.getMatrix();
+  S21ParallelFor(0, block_rows_, 1, [this, src](int from, int to) {
+    for (int bi = from; bi < to; ++bi) {
+      int row_end = std::min(rows_, (bi + 1) * tile_);
+      for (int bj = 0; bj < block_cols_; ++bj) {
+        double *dst = Tile(bi, bj);
+        int col_begin = bj * tile_;
+        int width = std::min(cols_, col_begin + tile_) - col_begin;
+        for (int i = bi * tile_; i < row_end; ++i) {
+          std::copy(src[i] + col_begin, src[i] + col_begin + width,
+                    dst + static_cast<size_t>(i - bi * tile_) * tile_);
+        }
+      }
+    }
+  });
+}
+
+// номер плитки в памяти для каждой пары (строка, столбец) плиток
+void S21TiledMatrix::BuildOffsets() {
+  const size_t count = static_cast<size_t>(block_rows_) * block_cols_;
+  std::vector<size_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  if (order_ == S21TileOrder::kMorton) {
+    const int width = block_cols_;
+    std::sort(order.begin(), order.end(), [width](size_t x, size_t y) {
+      return MortonCode(x / width, x % width) <
+             MortonCode(y / width, y % width);
+    });
+  }
+  const size_t tile_size = static_cast<size_t>(tile_) * tile_;
+  offsets_.assign(count, 0);
+  for (size_t rank = 0; rank < count; ++rank) {
+    offsets_[order[rank]] = rank * tile_size;
+  }
+}
+
+double *S21TiledMatrix::Tile(int block_row, int block_col) {
+  return data_.data() +
+         offsets_[static_cast<size_t>(block_row) * block_cols_ + block_col];
+}
+
+const double *S21TiledMatrix::Tile(int block_row, int block_col) const {
+  return data_.data() +
+         offsets_[static_cast<size_t>(block_row) * block_cols_ + block_col];
+}
+
+size_t S21TiledMatrix::Offset(int i, int j) const {
+  if (i < 0 || j < 0 || i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Matrix indices are out of range");
+  }
+  return offsets_[static_cast<size_t>(i / tile_) * block_cols_ + j / tile_] +
+         static_cast<size_t>(i % tile_) * tile_ + j % tile_;
+}
+
+double &S21TiledMatrix::operator()(int i, int j) { return data_[Offset(i, j)]; }
+
+double S21TiledMatrix::operator()(int i, int j) const {
+  return data_[Offset(i, j)];
+}
+
+bool S21TiledMatrix::operator==(const S21TiledMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      if ((*this)(i, j) != other(i, j)) return false;
+    }
+  }
+  return true;
+}
+
+S21Matrix S21TiledMatrix::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  double **dst = result.getMatrix();
+  S21ParallelFor(0, block_rows_, 1, [this, dst](int from, int to) {
+    for (int bi = from; bi < to; ++bi) {
+      int row_end = std::min(rows_, (bi + 1) * tile_);
+      for (int bj = 0; bj < block_cols_; ++bj) {
+        const double *src = Tile(bi, bj);
+        int col_begin = bj * tile_;
+        int width = std::min(cols_, col_begin + tile_) - col_begin;
+        for (int i = bi * tile_; i < row_end; ++i) {
+          const double *row = src + static_cast<size_t>(i - bi * tile_) * tile_;
+          std::copy(row, row + width, dst[i] + col_begin);
+        }
+      }
+    }
+  });
+  return result;
+}
+
+// Каждый поток получает строки плиток C; краевые плитки умножаются
+// только в пределах настоящих строк и столбцов
+S21TiledMatrix S21TiledMatrix::Multiply(const S21TiledMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrices cannot be multiplied: incompatible dimensions.");
+  }
+  if (tile_ != other.tile_) {
+    throw std::invalid_argument("Matrices must have the same tile size.");
+  }
+  S21TiledMatrix result(rows_, other.cols_, tile_, order_);
+  auto body = [this, &other, &result](int from, int to) {
+    for (int bi = from; bi < to; ++bi) {
+      const int rows = TileExtent(rows_, tile_, bi);
+      for (int bk = 0; bk < block_cols_; ++bk) {
+        const double *a = Tile(bi, bk);
+        const int depth = TileExtent(cols_, tile_, bk);
+        for (int bj = 0; bj < other.block_cols_; ++bj) {
+          MultiplyTile(tile_, rows, depth, TileExtent(other.cols_, tile_, bj),
+                       a, other.Tile(bk, bj), result.Tile(bi, bj));
+        }
+      }
+    }
+  };
+  if (static_cast<long long>(rows_) * cols_ * other.cols_ <
+      kParallelThreshold) {
+    body(0, block_rows_);
+  } else {
+    S21ParallelFor(0, block_rows_, 1, body);
+  }
+  return result;
+}
+
+// плитка (bi, bj) транспонируется в плитку (bj, bi) целиком в кеше
+S21TiledMatrix S21TiledMatrix::Transpose() const {
+  S21TiledMatrix result(cols_, rows_, tile_, order_);
+  S21ParallelFor(0, block_rows_, 1, [this, &result](int from, int to) {
+    for (int bi = from; bi < to; ++bi) {
+      for (int bj = 0; bj < block_cols_; ++bj) {
+        const double *src = Tile(bi, bj);
+        double *dst = result.Tile(bj, bi);
+        for (int i = 0; i < tile_; ++i) {
+          for (int j = 0; j < tile_; ++j) {
+            dst[static_cast<size_t>(j) * tile_ + i] =
+                src[static_cast<size_t>(i) * tile_ + j];
+          }
+        }
+      }
+    }
+  });
+  return result;
+}
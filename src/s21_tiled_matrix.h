@@ -0,0 +1,52 @@
+#ifndef S21_TILED_MATRIX_H
+#define S21_TILED_MATRIX_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// порядок плиток в памяти: по строкам плиток или по кривой Мортона
+enum class S21TileOrder { kBlockMajor, kMorton };
+
+// Матрица, хранящая элементы плитками tile x tile. Каждая плитка лежит
+// непрерывно (по строкам внутри плитки) и помещается в L1/L2, поэтому
+// умножение и транспонирование обходят память плитка за плиткой без
+// длинных шагов по строкам. Края дополняются нулями до целой плитки.
+class S21TiledMatrix {
+ public:
+  // 64 x 64 double = 32 КиБ, плитка A и строка плиток B помещаются в L2
+  static constexpr int kDefaultTile = 64;
+
+  S21TiledMatrix(int rows, int cols, int tile = kDefaultTile,
+                 S21TileOrder order = S21TileOrder::kBlockMajor);
+  explicit S21TiledMatrix(const S21Matrix &matrix, int tile = kDefaultTile,
+                          S21TileOrder order = S21TileOrder::kBlockMajor);
+
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  int getTile() const { return tile_; }
+  S21TileOrder getOrder() const { return order_; }
+  double &operator()(int i, int j);
+  double operator()(int i, int j) const;
+  bool operator==(const S21TiledMatrix &other) const;
+
+  S21Matrix ToMatrix() const;
+  // плитки обоих множителей должны быть одного размера
+  S21TiledMatrix Multiply(const S21TiledMatrix &other) const;
+  S21TiledMatrix Transpose() const;
+
+ private:
+  void BuildOffsets();
+  size_t Offset(int i, int j) const;
+  double *Tile(int block_row, int block_col);
+  const double *Tile(int block_row, int block_col) const;
+
+  int rows_, cols_, tile_;
+  S21TileOrder order_;
+  int block_rows_, block_cols_;
+  // начало плитки (block_row, block_col) в data_
+  std::vector<size_t> offsets_;
+  std::vector<double> data_;
+};
+
+#endif  // S21_TILED_MATRIX_H
@@ -675,6 +675,19 @@ TEST(S21MatrixTest, Determinant3x3Zero) {
   EXPECT_NEAR(result, 0.0, 1e-6);
 }
 
+// бесконечный или NaN элемент не превращается в нулевой определитель
+TEST(S21MatrixTest, DeterminantNonFinite) {
+  S21Matrix m(3, 3);
+  for (int i = 0; i < 3; ++i) m(i, i) = 2.0;
+  m(1, 1) = NAN;
+  EXPECT_TRUE(std::isnan(m.Determinant()));
+  m(1, 1) = INFINITY;
+  EXPECT_FALSE(std::isfinite(m.Determinant()));
+  EXPECT_THROW(m.InverseMatrix(), std::invalid_argument);
+  m(1, 1) = 0.0;
+  EXPECT_EQ(m.Determinant(), 0.0);
+}
+
 TEST(S21MatrixTest, GetMinor3x3Matrix) {
   S21Matrix m(3, 3);
   m(0, 0) = 1.0;
@@ -952,6 +965,1422 @@ TEST(S21MatrixTest, SetColsNegative) {
   EXPECT_THROW(m1.setCols(-1), std::invalid_argument);  // Ожидаем исключение
 }
 
+// заполнение матрицы детерминированными псевдослучайными значениями
+static void FillMatrix(S21Matrix &m, int seed) {
+  for (int i = 0; i < m.getRows(); ++i) {
+    for (int j = 0; j < m.getCols(); ++j) {
+      m(i, j) = ((i * 31 + j * 17 + seed * 7) % 23) / 4.0 - 2.5;
+    }
+  }
+}
+
+// Тестирование Gemm
+TEST(S21MatrixTest, GemmTransposedAccumulate) {
+  S21Matrix a(3, 4);
+  S21Matrix b(5, 4);
+  S21Matrix c(3, 5);
+  FillMatrix(a, 1);
+  FillMatrix(b, 2);
+  FillMatrix(c, 3);
+  S21Matrix expected = c;
+  expected.MulNumber(0.5);
+  S21Matrix product = a * b.Transpose();
+  product.MulNumber(2.0);
+  expected += product;
+
+  S21Matrix::Gemm(2.0, a, false, b, true, 0.5, c);
+  EXPECT_TRUE(c == expected);
+}
+
+TEST(S21MatrixTest, GemmBothTransposedBlocked) {
+  S21Matrix a(300, 150);
+  S21Matrix b(170, 300);
+  FillMatrix(a, 4);
+  FillMatrix(b, 5);
+  S21Matrix expected = a.Transpose() * b.Transpose();
+  S21Matrix c(150, 170);
+  int threads = S21GetThreadCount();
+  S21SetThreadCount(4);
+  S21Matrix::Gemm(1.0, a, true, b, true, 0.0, c);
+  S21SetThreadCount(threads);
+  for (int i = 0; i < 150; ++i) {
+    for (int j = 0; j < 170; ++j) {
+      double sum = 0.0;
+      for (int k = 0; k < 300; ++k) sum += a(k, i) * b(j, k);
+      EXPECT_NEAR(c(i, j), sum, 1e-9);
+    }
+  }
+  EXPECT_TRUE(c == expected);
+}
+
+TEST(S21MatrixTest, GemmAliasedOutput) {
+  S21Matrix a(2, 2);
+  a(0, 0) = 1.0;
+  a(0, 1) = 2.0;
+  a(1, 0) = 3.0;
+  a(1, 1) = 4.0;
+  S21Matrix::Gemm(1.0, a, false, a, false, 1.0, a);
+  EXPECT_EQ(a(0, 0), 8.0);
+  EXPECT_EQ(a(0, 1), 12.0);
+  EXPECT_EQ(a(1, 0), 18.0);
+  EXPECT_EQ(a(1, 1), 26.0);
+}
+
+// C - вид на ту же память, что и A, со сдвигом на строку; строк больше
+// одного блока ядра, так что A читается уже после записи в C
+TEST(S21MatrixTest, GemmOverlappingViews) {
+  const int n = 100;
+  std::vector<double> buffer(static_cast<size_t>(n + 1) * n);
+  for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = std::sin(i * 0.1);
+  S21Matrix a = S21Matrix::View(buffer.data(), n, n);
+  S21Matrix c = S21Matrix::View(buffer.data() + n, n, n);
+  S21Matrix a_copy(n, n), c_copy(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a_copy(i, j) = a(i, j);
+      c_copy(i, j) = c(i, j);
+    }
+  }
+  S21Matrix::Gemm(2.0, a, false, a, true, 1.0, c);
+  S21Matrix::Gemm(2.0, a_copy, false, a_copy, true, 1.0, c_copy);
+  EXPECT_TRUE(c.IsView());
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) ASSERT_EQ(c(i, j), c_copy(i, j));
+  }
+}
+
+TEST(S21MatrixTest, GemmInvalidDimensions) {
+  S21Matrix a(2, 3);
+  S21Matrix b(2, 3);
+  S21Matrix c(2, 2);
+  EXPECT_THROW(S21Matrix::Gemm(1.0, a, false, b, false, 0.0, c),
+               std::invalid_argument);
+  S21Matrix wrong(3, 3);
+  EXPECT_THROW(S21Matrix::Gemm(1.0, a, false, b, true, 0.0, wrong),
+               std::invalid_argument);
+}
+
+// Тестирование Syrk и Gram
+TEST(S21MatrixTest, GramMatchesTransposeProduct) {
+  // обычный, блочный по столбцам C и узкий высокий (деление k) случаи
+  for (auto [rows, cols] : {std::pair{5, 3}, {80, 600}, {20000, 40}}) {
+    S21Matrix a(rows, cols);
+    FillMatrix(a, rows);
+    S21Matrix gram = a.Gram();
+    S21Matrix expected = a.Transpose() * a;
+    ASSERT_EQ(gram.getRows(), cols);
+    for (int i = 0; i < cols; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        EXPECT_NEAR(gram(i, j), expected(i, j),
+                    1e-12 * rows * (1.0 + std::fabs(expected(i, j))));
+        EXPECT_EQ(gram(i, j), gram(j, i));
+      }
+    }
+  }
+}
+
+TEST(S21MatrixTest, SyrkAccumulateAndAliasing) {
+  S21Matrix a(70, 90);
+  FillMatrix(a, 2);
+  S21Matrix c(70, 70);
+  FillMatrix(c, 3);
+  // верхний треугольник C не читается
+  S21Matrix expected(c);
+  for (int i = 0; i < 70; ++i) {
+    for (int j = i + 1; j < 70; ++j) expected(i, j) = expected(j, i);
+  }
+  S21Matrix::Gemm(2.0, a, false, a, true, 0.5, expected);
+  S21Matrix::Syrk(2.0, a, false, 0.5, c);
+  EXPECT_TRUE(c == expected);
+
+  S21Matrix square(6, 6);
+  FillMatrix(square, 4);
+  S21Matrix product = square.Transpose() * square;
+  S21Matrix::Syrk(1.0, square, true, 0.0, square);
+  EXPECT_TRUE(square == product);
+
+  S21Matrix wrong(90, 90);
+  EXPECT_THROW(S21Matrix::Syrk(1.0, a, false, 0.0, wrong),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, SyrkOverlappingViews) {
+  const int n = 100;
+  std::vector<double> buffer(static_cast<size_t>(n + 1) * n);
+  for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = std::sin(i * 0.1);
+  S21Matrix a = S21Matrix::View(buffer.data(), n, n);
+  S21Matrix c = S21Matrix::View(buffer.data() + n, n, n);
+  S21Matrix a_copy(n, n), c_copy(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a_copy(i, j) = a(i, j);
+      c_copy(i, j) = c(i, j);
+    }
+  }
+  S21Matrix::Syrk(1.0, a, false, 1.0, c);
+  S21Matrix::Syrk(1.0, a_copy, false, 1.0, c_copy);
+  EXPECT_TRUE(c.IsView());
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) ASSERT_EQ(c(i, j), c_copy(i, j));
+  }
+}
+
+// Тестирование Solve и смешанной точности
+TEST(S21MatrixTest, SolveDouble) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 2.0;
+  a(0, 1) = 1.0;
+  a(0, 2) = -1.0;
+  a(1, 0) = -3.0;
+  a(1, 1) = -1.0;
+  a(1, 2) = 2.0;
+  a(2, 0) = -2.0;
+  a(2, 1) = 1.0;
+  a(2, 2) = 2.0;
+  S21Matrix b(3, 1);
+  b(0, 0) = 8.0;
+  b(1, 0) = -11.0;
+  b(2, 0) = -3.0;
+  S21Matrix x = a.Solve(b);
+  EXPECT_NEAR(x(0, 0), 2.0, 1e-12);
+  EXPECT_NEAR(x(1, 0), 3.0, 1e-12);
+  EXPECT_NEAR(x(2, 0), -1.0, 1e-12);
+}
+
+TEST(S21MatrixTest, SolveMixedReachesDoubleAccuracy) {
+  const int n = 60;
+  S21Matrix a(n, n);
+  FillMatrix(a, 6);
+  for (int i = 0; i < n; ++i) a(i, i) += 3.0 * n;
+  S21Matrix b(n, 2);
+  FillMatrix(b, 7);
+  S21Matrix x = a.Solve(b, S21Precision::kMixed);
+  S21Matrix residual = a * x - b;
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NEAR(residual(i, 0), 0.0, 1e-12);
+    EXPECT_NEAR(residual(i, 1), 0.0, 1e-12);
+  }
+}
+
+TEST(S21MatrixTest, InverseMixedMatchesDouble) {
+  S21Matrix m1(3, 3);
+  m1(0, 0) = 2.0;
+  m1(0, 1) = -1.0;
+  m1(1, 0) = -1.0;
+  m1(1, 1) = 2.0;
+  m1(1, 2) = -1.0;
+  m1(2, 1) = -1.0;
+  m1(2, 2) = 2.0;
+  S21Matrix mixed = m1.InverseMatrix(S21Precision::kMixed);
+  S21Matrix exact = m1.InverseMatrix();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) EXPECT_NEAR(mixed(i, j), exact(i, j), 1e-14);
+  }
+}
+
+TEST(S21MatrixTest, SolveMixedIllConditionedFallsBack) {
+  // матрица Гильберта 10x10 слишком плохо обусловлена для float
+  const int n = 10;
+  S21Matrix hilbert(n, n);
+  S21Matrix b(n, 1);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      hilbert(i, j) = 1.0 / (i + j + 1);
+      b(i, 0) += hilbert(i, j);
+    }
+  }
+  S21Matrix mixed = hilbert.Solve(b, S21Precision::kMixed);
+  S21Matrix exact = hilbert.Solve(b);
+  for (int i = 0; i < n; ++i) EXPECT_DOUBLE_EQ(mixed(i, 0), exact(i, 0));
+}
+
+// Блочное LU: порядок больше двух панелей и не кратен их ширине
+TEST(S21MatrixTest, BlockedLUDeterminantSolveInverse) {
+  const int n = 301;
+  // A = L * U с известным определителем prod(U_ii), первая и последняя
+  // строки переставлены
+  S21Matrix l(n, n), u(n, n);
+  double log_det = 0.0;
+  for (int i = 0; i < n; ++i) {
+    l(i, i) = 1.0;
+    u(i, i) = 1.0 + 0.002 * i;
+    log_det += std::log(u(i, i));
+    for (int j = 0; j < i; ++j) l(i, j) = std::sin(i * 0.7 + j * 1.3) * 3.0 / n;
+    for (int j = i + 1; j < n; ++j) u(i, j) = std::cos(i * 0.4 + j) * 3.0 / n;
+  }
+  S21Matrix a = l * u;
+  for (int j = 0; j < n; ++j) std::swap(a(0, j), a(n - 1, j));
+  EXPECT_NEAR(std::log(-a.Determinant()), log_det, 1e-9);
+
+  S21Matrix b(n, 20);
+  FillMatrix(b, 8);
+  S21Matrix residual = a * a.Solve(b) - b;
+  EXPECT_LT(residual.MaxAbs(), 1e-8);
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; ++i) identity(i, i) = 1.0;
+  EXPECT_TRUE(a * a.InverseMatrix() == identity);
+  EXPECT_TRUE(a * a.InverseMatrix(S21Precision::kMixed) == identity);
+
+  // две равные строки
+  for (int j = 0; j < n; ++j) a(200, j) = a(10, j);
+  EXPECT_EQ(a.Determinant(), 0.0);
+  EXPECT_THROW(a.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, InverseMixedRejectsNearlySingular) {
+  // rcond около 1e-17: float-разложение не вырождено из-за округлений,
+  // но обратная матрица бессмысленна, как и в пути double
+  S21Matrix m1(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) m1(i, j) = 3 * i + j + 1;
+  }
+  m1(2, 2) += 1e-15;
+  EXPECT_THROW(m1.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(m1.InverseMatrix(S21Precision::kMixed), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, SolveInvalidArguments) {
+  S21Matrix singular(2, 2);
+  singular(0, 0) = 1.0;
+  singular(0, 1) = 2.0;
+  singular(1, 0) = 2.0;
+  singular(1, 1) = 4.0;
+  S21Matrix b(2, 1);
+  EXPECT_THROW(singular.Solve(b, S21Precision::kMixed), std::invalid_argument);
+  EXPECT_THROW(singular.Solve(S21Matrix(3, 1)), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(2, 3).InverseMatrix(S21Precision::kMixed),
+               std::invalid_argument);
+}
+
+// Тестирование асинхронных операций
+TEST(S21MatrixTest, MultiplyAsyncMatchesMultiply) {
+  S21Matrix a(40, 30);
+  S21Matrix b(30, 20);
+  FillMatrix(a, 8);
+  FillMatrix(b, 9);
+  S21Future<S21Matrix> product = a.MultiplyAsync(b);
+  FillMatrix(a, 10);  // аргументы скопированы при запуске
+  S21Matrix a_original(40, 30);
+  FillMatrix(a_original, 8);
+  EXPECT_TRUE(product.Get() == a_original * b);
+}
+
+TEST(S21MatrixTest, AsyncChainWithThen) {
+  S21Matrix m(2, 2);
+  m(0, 0) = 4.0;
+  m(0, 1) = 7.0;
+  m(1, 0) = 2.0;
+  m(1, 1) = 6.0;
+  S21Future<double> det = m.InverseAsync()
+                              .Then([](const S21Matrix &inv) {
+                                return inv.Multiply(inv);
+                              })
+                              .Then([](const S21Matrix &sq) {
+                                return sq.Determinant();
+                              });
+  EXPECT_NEAR(det.Get(), 0.01, 1e-12);
+  EXPECT_NEAR(m.DeterminantAsync().Get(), 10.0, 1e-12);
+}
+
+TEST(S21MatrixTest, AsyncPropagatesExceptions) {
+  S21Matrix singular(2, 2);
+  S21Future<S21Matrix> inverse = singular.InverseAsync();
+  S21Future<double> chained =
+      inverse.Then([](const S21Matrix &inv) { return inv(0, 0); });
+  EXPECT_THROW(inverse.Get(), std::invalid_argument);
+  EXPECT_THROW(chained.Get(), std::invalid_argument);
+  EXPECT_THROW(S21Future<double>().Get(), std::logic_error);
+}
+
+// задач больше, чем потоков пула, и каждая ждёт вложенную
+TEST(S21MatrixTest, FutureGetInsidePoolTask) {
+  const int tasks = 2 * S21Executor::Instance().getWorkerCount() + 2;
+  std::vector<S21Future<int>> outer;
+  for (int i = 0; i < tasks; ++i) {
+    outer.push_back(S21Async([i]() {
+      return S21Async([i]() { return i * i; }).Get() + 1;
+    }));
+  }
+  for (int i = 0; i < tasks; ++i) EXPECT_EQ(outer[i].Get(), i * i + 1);
+}
+
+// Тестирование планировщика с перехватом работы
+TEST(S21MatrixTest, TaskGroupNestedForkJoin) {
+  std::atomic<int> leaves{0};
+  std::function<void(int)> fork = [&](int depth) {
+    if (depth == 0) {
+      leaves.fetch_add(1);
+      return;
+    }
+    S21TaskGroup group;
+    group.Run([&fork, depth]() { fork(depth - 1); });
+    group.Run([&fork, depth]() { fork(depth - 1); });
+    group.Wait();
+  };
+  fork(10);
+  EXPECT_EQ(leaves.load(), 1024);
+}
+
+TEST(S21MatrixTest, TaskGroupRethrows) {
+  S21TaskGroup group;
+  group.Run([]() { throw std::runtime_error("task failed"); });
+  group.Run([]() {});
+  EXPECT_THROW(group.Wait(), std::runtime_error);
+}
+
+TEST(S21MatrixTest, ParallelDeterminantAndComplements) {
+  const int n = 8;
+  S21Matrix m(n, n);
+  FillMatrix(m, 11);
+  for (int i = 0; i < n; ++i) m(i, i) += 5.0;
+  int threads = S21GetThreadCount();
+  S21SetThreadCount(1);
+  double serial_det = m.Determinant();
+  S21Matrix serial_complements = m.CalcComplements();
+  S21SetThreadCount(4);
+  EXPECT_EQ(m.Determinant(), serial_det);
+  EXPECT_TRUE(m.CalcComplements() == serial_complements);
+  S21SetThreadCount(threads);
+  // разложение по первой строке через алгебраические дополнения
+  double expansion = 0.0;
+  for (int j = 0; j < n; ++j) expansion += m(0, j) * serial_complements(0, j);
+  EXPECT_NEAR(expansion, serial_det, 1e-6 * std::fabs(serial_det));
+}
+
+// Тестирование матриц со структурой
+TEST(S21MatrixTest, SymmetricPackedMultiply) {
+  S21Matrix full(5, 5);
+  FillMatrix(full, 12);
+  full += full.Transpose();
+  S21SymmetricMatrix sym(full);
+  EXPECT_EQ(sym(1, 3), sym(3, 1));
+  EXPECT_TRUE(sym.ToMatrix() == full);
+  S21Matrix b(5, 3);
+  FillMatrix(b, 13);
+  EXPECT_TRUE(sym.Multiply(b) == full * b);
+  full(0, 1) += 1.0;
+  EXPECT_THROW(S21SymmetricMatrix{full}, std::invalid_argument);
+}
+
+TEST(S21MatrixTest, TriangularMultiplySolve) {
+  S21Matrix full(6, 6);
+  FillMatrix(full, 14);
+  for (int i = 0; i < 6; ++i) full(i, i) = 3.0 + i;
+  S21Matrix b(6, 2);
+  FillMatrix(b, 15);
+  for (S21Triangle part : {S21Triangle::kLower, S21Triangle::kUpper}) {
+    S21TriangularMatrix tri(full, part);
+    S21Matrix dense = tri.ToMatrix();
+    EXPECT_EQ(dense(0, 5) == 0.0, part == S21Triangle::kLower);
+    EXPECT_TRUE(tri.Multiply(b) == dense * b);
+    EXPECT_TRUE(tri.Multiply(tri.Solve(b)) == b);
+    EXPECT_NEAR(tri.Determinant(), dense.Determinant(), 1e-9);
+  }
+  S21TriangularMatrix lower(3, S21Triangle::kLower);
+  EXPECT_THROW(lower(0, 2) = 1.0, std::out_of_range);
+  EXPECT_THROW(lower.Solve(S21Matrix(3, 1)), std::invalid_argument);
+
+  // определитель 0.1^400 уходит в ноль, но матрица хорошо обусловлена
+  const int n = 400;
+  S21TriangularMatrix scaled(n, S21Triangle::kLower);
+  for (int i = 0; i < n; ++i) scaled(i, i) = 0.1;
+  EXPECT_EQ(scaled.Determinant(), 0.0);
+  S21Matrix ones(n, 1);
+  for (int i = 0; i < n; ++i) ones(i, 0) = 1.0;
+  S21Matrix x = scaled.Solve(ones);
+  EXPECT_NEAR(x(n - 1, 0), 10.0, 1e-9);
+}
+
+TEST(S21MatrixTest, BandMultiplySolveDeterminant) {
+  const int n = 40;
+  S21Matrix full(n, n);
+  S21BandMatrix band(n, 2, 1);
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - 2); j <= std::min(n - 1, i + 1); ++j) {
+      // малая диагональ заставляет ленточное LU переставлять строки
+      band(i, j) = full(i, j) = (i == j) ? 0.5 : ((i * 7 + j * 3) % 5) - 2.0;
+    }
+  }
+  const S21BandMatrix &view = band;
+  EXPECT_EQ(view(0, 5), 0.0);
+  EXPECT_THROW(band(0, 5) = 1.0, std::out_of_range);
+  EXPECT_TRUE(band.ToMatrix() == full);
+  EXPECT_TRUE(S21BandMatrix(full, 2, 1).ToMatrix() == full);
+  S21Matrix b(n, 3);
+  FillMatrix(b, 16);
+  EXPECT_TRUE(band.Multiply(b) == full * b);
+  S21Matrix x = band.Solve(b);
+  EXPECT_TRUE(full * x == b);
+  S21Matrix small(6, 6);
+  for (int i = 0; i < 6; ++i) {
+    for (int j = std::max(0, i - 2); j <= std::min(5, i + 1); ++j) {
+      small(i, j) = full(i, j);
+    }
+  }
+  EXPECT_NEAR(S21BandMatrix(small, 2, 1).Determinant(), small.Determinant(),
+              1e-9);
+  EXPECT_EQ(S21BandMatrix(4, 1, 1).Determinant(), 0.0);
+  EXPECT_THROW(S21BandMatrix(4, 1, 1).Solve(S21Matrix(4, 1)),
+               std::invalid_argument);
+}
+
+// Тестирование хранения маленьких матриц внутри объекта
+static bool StoredInline(const S21Matrix &m) {
+  const char *begin = reinterpret_cast<const char *>(&m);
+  const char *rows = reinterpret_cast<const char *>(m.getMatrix());
+  const char *data = reinterpret_cast<const char *>(m.getMatrix()[0]);
+  return rows >= begin && rows < begin + sizeof(m) && data >= begin &&
+         data < begin + sizeof(m);
+}
+
+TEST(S21MatrixTest, SmallMatricesStoredInline) {
+  EXPECT_TRUE(StoredInline(S21Matrix()));
+  EXPECT_TRUE(StoredInline(S21Matrix(4, 4)));
+  EXPECT_TRUE(StoredInline(S21Matrix(1, 16)));
+  EXPECT_FALSE(StoredInline(S21Matrix(5, 1)));
+  EXPECT_FALSE(StoredInline(S21Matrix(4, 5)));
+  S21Matrix big(8, 8);
+  EXPECT_EQ(big.getMatrix()[1], big.getMatrix()[0] + 8);
+}
+
+TEST(S21MatrixTest, SmallMatrixMoveAndSwap) {
+  S21Matrix small(2, 2);
+  small(1, 1) = 3.0;
+  S21Matrix moved(std::move(small));
+  EXPECT_TRUE(StoredInline(moved));
+  EXPECT_EQ(moved(1, 1), 3.0);
+  EXPECT_EQ(small.getMatrix(), nullptr);
+
+  S21Matrix big(6, 6);
+  big(5, 5) = 7.0;
+  double *big_data = big.getMatrix()[0];
+  moved.swap(big);
+  EXPECT_EQ(moved.getRows(), 6);
+  EXPECT_EQ(moved.getMatrix()[0], big_data);
+  EXPECT_EQ(moved(5, 5), 7.0);
+  EXPECT_TRUE(StoredInline(big));
+  EXPECT_EQ(big(1, 1), 3.0);
+
+  big = moved;
+  moved = big.GetMinor(0, 0).GetMinor(0, 0);
+  EXPECT_TRUE(StoredInline(moved));
+  EXPECT_EQ(moved(3, 3), 7.0);
+  moved = moved;
+  EXPECT_EQ(moved(3, 3), 7.0);
+}
+
+// Тестирование поэлементных операций и свёрток
+TEST(S21MatrixTest, ApplyAndZip) {
+  S21Matrix m(3, 3);
+  FillMatrix(m, 17);
+  S21Matrix expected = m;
+  expected.MulNumber(2.0);
+  m.Apply([](double x) { return 2.0 * x; });
+  EXPECT_TRUE(m == expected);
+  m.Apply([](double x) { return std::min(1.0, std::max(-1.0, x)); });
+  EXPECT_LE(m.MaxAbs(), 1.0);
+  S21Matrix other(3, 3);
+  FillMatrix(other, 18);
+  S21Matrix sum = m + other;
+  m.Zip(other, [](double x, double y) { return x + y; });
+  EXPECT_TRUE(m == sum);
+  EXPECT_THROW(m.Zip(S21Matrix(2, 3), [](double x, double) { return x; }),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, BuiltinReductions) {
+  S21Matrix m(2, 3);
+  m(0, 0) = 1.0;
+  m(0, 1) = -2.0;
+  m(0, 2) = 3.0;
+  m(1, 0) = -4.0;
+  m(1, 1) = 5.0;
+  m(1, 2) = 6.0;
+  EXPECT_DOUBLE_EQ(m.Sum(), 9.0);
+  EXPECT_DOUBLE_EQ(m.FrobeniusNorm(), std::sqrt(91.0));
+  EXPECT_DOUBLE_EQ(m.MaxAbs(), 6.0);
+  EXPECT_DOUBLE_EQ(m.Reduce(1.0, [](double a, double b) { return a * b; }),
+                   720.0);
+  EXPECT_THROW(m.Trace(), std::invalid_argument);
+  S21Matrix square(3, 3);
+  FillMatrix(square, 19);
+  EXPECT_DOUBLE_EQ(square.Trace(), square(0, 0) + square(1, 1) + square(2, 2));
+}
+
+TEST(S21MatrixTest, ReductionsDeterministicAcrossThreads) {
+  S21Matrix m(300, 300);
+  for (int i = 0; i < 300; ++i) {
+    for (int j = 0; j < 300; ++j) m(i, j) = 1.0 / (1.0 + i * 300 + j);
+  }
+  int threads = S21GetThreadCount();
+  S21SetThreadCount(1);
+  double sum = m.Sum();
+  double norm = m.FrobeniusNorm();
+  S21SetThreadCount(4);
+  EXPECT_EQ(m.Sum(), sum);
+  EXPECT_EQ(m.FrobeniusNorm(), norm);
+  EXPECT_EQ(m.Reduce(0.0, [](double a, double b) { return a + b; }, false),
+            m.Reduce(0.0, [](double a, double b) { return a + b; }));
+  S21SetThreadCount(threads);
+}
+
+// Тестирование Power
+TEST(S21MatrixTest, PowerMatchesRepeatedMultiply) {
+  S21Matrix m(5, 5);
+  FillMatrix(m, 20);
+  m.MulNumber(0.2);
+  S21Matrix expected = m;
+  for (int i = 1; i < 13; ++i) expected *= m;
+  EXPECT_TRUE(m.Power(13) == expected);
+  EXPECT_TRUE(m.Power(1) == m);
+  S21Matrix identity = m.Power(0);
+  EXPECT_DOUBLE_EQ(identity.Trace(), 5.0);
+  EXPECT_DOUBLE_EQ(identity.Sum(), 5.0);
+}
+
+TEST(S21MatrixTest, PowerFibonacciAndNegative) {
+  S21Matrix fib(2, 2);
+  fib(0, 0) = 1.0;
+  fib(0, 1) = 1.0;
+  fib(1, 0) = 1.0;
+  S21Matrix f = fib.Power(50);
+  EXPECT_DOUBLE_EQ(f(0, 1), 12586269025.0);
+  S21Matrix inv = fib.Power(-3);
+  EXPECT_TRUE(inv * fib.Power(3) == S21Matrix(2, 2).Power(0));
+  EXPECT_THROW(S21Matrix(2, 2).Power(-1), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(2, 3).Power(2), std::invalid_argument);
+}
+
+// Тестирование ConditionEstimate и отказа для почти вырожденных матриц
+static double ColumnNorm1(const S21Matrix &m) {
+  double norm = 0.0;
+  for (int j = 0; j < m.getCols(); ++j) {
+    double sum = 0.0;
+    for (int i = 0; i < m.getRows(); ++i) sum += std::fabs(m(i, j));
+    norm = std::max(norm, sum);
+  }
+  return norm;
+}
+
+TEST(S21MatrixTest, ConditionEstimateMatchesExact) {
+  S21Matrix m(6, 6);
+  FillMatrix(m, 21);
+  for (int i = 0; i < 6; ++i) m(i, i) += 4.0;
+  double exact = ColumnNorm1(m) * ColumnNorm1(m.InverseMatrix());
+  double estimate = m.ConditionEstimate();
+  EXPECT_LE(estimate, exact * (1.0 + 1e-12));
+  EXPECT_GE(estimate, exact / 3.0);
+
+  S21Matrix diag(3, 3);
+  diag(0, 0) = 1.0;
+  diag(1, 1) = 1e-3;
+  diag(2, 2) = 10.0;
+  EXPECT_NEAR(diag.ConditionEstimate(), 1e4, 1e-6);
+  EXPECT_EQ(S21Matrix(2, 2).ConditionEstimate(), INFINITY);
+  EXPECT_THROW(S21Matrix(2, 3).ConditionEstimate(), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, InverseRejectsNearSingular) {
+  S21Matrix m(2, 2);
+  m(0, 0) = 1.0;
+  m(0, 1) = 1.0;
+  m(1, 0) = 1.0;
+  m(1, 1) = 1.0 + 4e-16;
+  EXPECT_NE(m.Determinant(), 0.0);
+  EXPECT_THROW(m.InverseMatrix(), std::invalid_argument);
+  EXPECT_NO_THROW(m.InverseMatrix(0.0));
+
+  S21Matrix diag(2, 2);
+  diag(0, 0) = 1.0;
+  diag(1, 1) = 1e-4;
+  EXPECT_NO_THROW(diag.InverseMatrix());
+  EXPECT_THROW(diag.InverseMatrix(1e-3), std::invalid_argument);
+}
+
+// Тестирование чтения и записи текстовых форматов
+static void WriteFile(const std::string &path, const std::string &text) {
+  FILE *file = std::fopen(path.c_str(), "wb");
+  std::fputs(text.c_str(), file);
+  std::fclose(file);
+}
+
+TEST(S21MatrixTest, TextRoundTripAllFormats) {
+  S21Matrix m(7, 5);
+  FillMatrix(m, 22);
+  m(0, 0) = 0.1;
+  m(1, 1) = -1e-300;
+  m(2, 2) = 123456789.123456789;
+  const std::string path = "s21_io_test.txt";
+  for (S21TextFormat format :
+       {S21TextFormat::kCsv, S21TextFormat::kWhitespace,
+        S21TextFormat::kMatrixMarket}) {
+    m.SaveText(path, format);
+    S21Matrix loaded = S21Matrix::LoadText(path);
+    ASSERT_EQ(loaded.getRows(), 7);
+    ASSERT_EQ(loaded.getCols(), 5);
+    for (int i = 0; i < 7; ++i) {
+      for (int j = 0; j < 5; ++j) EXPECT_EQ(loaded(i, j), m(i, j));
+    }
+  }
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixTest, LoadTextHandwritten) {
+  const std::string path = "s21_io_test.txt";
+  WriteFile(path, "1, +2.5 ,-3e2\r\n\n4,5,6\n");
+  S21Matrix csv = S21Matrix::LoadText(path);
+  EXPECT_EQ(csv.getRows(), 2);
+  EXPECT_EQ(csv(0, 1), 2.5);
+  EXPECT_EQ(csv(0, 2), -300.0);
+  EXPECT_EQ(csv(1, 2), 6.0);
+
+  WriteFile(path, "1\t2\n  3 4  \n");
+  S21Matrix spaces = S21Matrix::LoadText(path, S21TextFormat::kWhitespace);
+  EXPECT_EQ(spaces(1, 0), 3.0);
+  EXPECT_EQ(spaces(1, 1), 4.0);
+
+  WriteFile(path,
+            "%%MatrixMarket matrix coordinate real symmetric\n"
+            "% comment\n3 3 3\n1 1 2.0\n3 1 -1.5\n2 2 4\n");
+  S21Matrix market = S21Matrix::LoadText(path);
+  EXPECT_EQ(market(0, 0), 2.0);
+  EXPECT_EQ(market(2, 0), -1.5);
+  EXPECT_EQ(market(0, 2), -1.5);
+  EXPECT_EQ(market(1, 1), 4.0);
+  EXPECT_EQ(market(2, 2), 0.0);
+
+  WriteFile(path, "1,2\n3\n");
+  EXPECT_THROW(S21Matrix::LoadText(path), std::invalid_argument);
+  WriteFile(path, "1,x\n");
+  EXPECT_THROW(S21Matrix::LoadText(path), std::invalid_argument);
+  WriteFile(path, "%%MatrixMarket matrix array real general\n2 2\n1 2 3\n");
+  EXPECT_THROW(S21Matrix::LoadText(path), std::invalid_argument);
+  std::remove(path.c_str());
+  EXPECT_THROW(S21Matrix::LoadText("missing_s21_matrix.csv"),
+               std::runtime_error);
+}
+
+TEST(S21MatrixTest, TextParallelParse) {
+  S21Matrix m(2000, 60);
+  for (int i = 0; i < 2000; ++i) {
+    for (int j = 0; j < 60; ++j) m(i, j) = (i * 60 + j) / 7.0;
+  }
+  const std::string path = "s21_io_test.txt";
+  int threads = S21GetThreadCount();
+  S21SetThreadCount(4);
+  m.SaveText(path, S21TextFormat::kWhitespace);
+  S21Matrix loaded = S21Matrix::LoadText(path);
+  S21SetThreadCount(threads);
+  std::remove(path.c_str());
+  ASSERT_EQ(loaded.getRows(), 2000);
+  EXPECT_EQ(loaded(1999, 59), m(1999, 59));
+  EXPECT_TRUE(loaded == m);
+}
+
+// Тестирование EigenSymmetric
+TEST(S21MatrixTest, EigenSymmetricKnownSpectrum) {
+  // у матрицы tridiag(-1, 2, -1) собственные значения 2 - 2cos(k*pi/(n+1))
+  const int n = 100;
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; ++i) {
+    m(i, i) = 2.0;
+    if (i > 0) m(i, i - 1) = m(i - 1, i) = -1.0;
+  }
+  std::vector<double> values = m.EigenSymmetric();
+  ASSERT_EQ(values.size(), static_cast<size_t>(n));
+  for (int k = 1; k <= n; ++k) {
+    EXPECT_NEAR(values[k - 1], 2.0 - 2.0 * std::cos(k * M_PI / (n + 1)),
+                1e-12);
+  }
+}
+
+TEST(S21MatrixTest, EigenSymmetricVectors) {
+  const int n = 70;
+  S21Matrix m(n, n);
+  FillMatrix(m, 23);
+  m += m.Transpose();
+  S21Matrix vectors;
+  std::vector<double> values = m.EigenSymmetric(vectors);
+  std::vector<double> only_values = m.EigenSymmetric();
+  for (int k = 0; k < n; ++k) EXPECT_NEAR(values[k], only_values[k], 1e-10);
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  S21Matrix av = m * vectors;
+  S21Matrix gram = vectors.Transpose() * vectors;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      EXPECT_NEAR(av(i, j), vectors(i, j) * values[j], 1e-9);
+      EXPECT_NEAR(gram(i, j), i == j ? 1.0 : 0.0, 1e-12);
+    }
+  }
+  EXPECT_NEAR(std::accumulate(values.begin(), values.end(), 0.0), m.Trace(),
+              1e-9);
+}
+
+TEST(S21MatrixTest, EigenSymmetricInvalid) {
+  S21Matrix m(2, 2);
+  m(0, 1) = 1.0;
+  EXPECT_THROW(m.EigenSymmetric(), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(2, 3).EigenSymmetric(), std::invalid_argument);
+  S21Matrix one;
+  one(0, 0) = 5.0;
+  EXPECT_EQ(one.EigenSymmetric()[0], 5.0);
+}
+
+// Тестирование TruncatedSvd
+TEST(S21MatrixTest, TruncatedSvdRecoversLowRank) {
+  S21Matrix left(120, 5);
+  S21Matrix right(5, 90);
+  FillMatrix(left, 24);
+  FillMatrix(right, 25);
+  for (int i = 0; i < 5; ++i) right(i, i) += 10.0 * (i + 1);
+  S21Matrix a = left * right;
+  S21SvdResult svd = a.TruncatedSvd(5);
+  ASSERT_EQ(svd.u.getRows(), 120);
+  ASSERT_EQ(svd.u.getCols(), 5);
+  ASSERT_EQ(svd.v.getRows(), 90);
+  S21Matrix scaled_u = svd.u;
+  for (int i = 0; i < 120; ++i) {
+    for (int j = 0; j < 5; ++j) scaled_u(i, j) *= svd.s[j];
+  }
+  S21Matrix restored = scaled_u * svd.v.Transpose();
+  EXPECT_LT((restored - a).MaxAbs(), 1e-9 * a.MaxAbs());
+  S21Matrix gram = svd.u.Transpose() * svd.u;
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) EXPECT_NEAR(gram(i, j), i == j, 1e-12);
+  }
+}
+
+TEST(S21MatrixTest, TruncatedSvdMatchesSpectrum) {
+  S21Matrix a(80, 50);
+  FillMatrix(a, 26);
+  // выраженный разрыв после шестого сингулярного числа
+  for (int i = 0; i < 6; ++i) a(i, i) += 1000.0 / (i + 1);
+  std::vector<double> exact = (a.Transpose() * a).EigenSymmetric();
+  S21SvdResult svd = a.TruncatedSvd(6, 10, 3, 7);
+  for (int k = 0; k < 6; ++k) {
+    EXPECT_NEAR(svd.s[k], std::sqrt(exact[49 - k]), 1e-9 * svd.s[0]);
+  }
+  EXPECT_TRUE(std::is_sorted(svd.s.rbegin(), svd.s.rend()));
+  EXPECT_THROW(a.TruncatedSvd(0), std::invalid_argument);
+  EXPECT_THROW(a.TruncatedSvd(51), std::invalid_argument);
+}
+
+// Тестирование размещения NUMA
+TEST(S21MatrixTest, NumaPoliciesPreserveContents) {
+  const int n = 600;  // буфер больше порога параллельного заполнения
+  S21Matrix source(n, n);
+  FillMatrix(source, 27);
+  for (S21NumaPolicy policy :
+       {S21NumaPolicy::kAllocatingThread, S21NumaPolicy::kFirstTouch,
+        S21NumaPolicy::kInterleave, S21NumaPolicy::kNode}) {
+    S21SetNumaPolicy(policy);
+    EXPECT_EQ(S21GetNumaPolicy(), policy);
+    S21Matrix zeros(n, n);
+    EXPECT_EQ(zeros.MaxAbs(), 0.0);
+    S21Matrix copy(source);
+    EXPECT_TRUE(copy == source);
+  }
+  S21SetNumaPolicy(S21NumaPolicy::kFirstTouch);
+  EXPECT_GE(S21NumaNodeCount(), 1);
+  EXPECT_THROW(S21SetNumaPolicy(S21NumaPolicy::kNode, -1),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, ParallelForStaticKeepsOwners) {
+  int threads = S21GetThreadCount();
+  S21SetThreadCount(4);
+  S21SetThreadPinning(true);
+  EXPECT_TRUE(S21GetThreadPinning());
+  const int n = 1000;
+  std::vector<std::thread::id> first(n), second(n);
+  S21ParallelForStatic(0, n, [&first](int from, int to) {
+    for (int i = from; i < to; ++i) first[i] = std::this_thread::get_id();
+  });
+  S21ParallelForStatic(0, n, [&second](int from, int to) {
+    for (int i = from; i < to; ++i) second[i] = std::this_thread::get_id();
+  });
+  EXPECT_TRUE(first == second);
+  S21SetThreadPinning(false);
+  EXPECT_FALSE(S21GetThreadPinning());
+  S21SetThreadCount(threads);
+}
+
+// Тестирование копирования при записи
+TEST(S21MatrixTest, CopyOnWriteSharesUntilWrite) {
+  S21Matrix a(50, 40);
+  FillMatrix(a, 28);
+  S21Matrix plain(a);
+  EXPECT_FALSE(plain.IsCopyOnWrite());
+  EXPECT_NE(plain.getMatrix()[0], a.getMatrix()[0]);
+
+  a.EnableCopyOnWrite();
+  S21Matrix b(a);
+  S21Matrix c;
+  c = b;
+  EXPECT_TRUE(a.IsShared());
+  EXPECT_EQ(b.getMatrix()[0], a.getMatrix()[0]);
+  EXPECT_EQ(c.getMatrix()[0], a.getMatrix()[0]);
+
+  const S21Matrix &view = b;
+  EXPECT_EQ(view(3, 4), plain(3, 4));
+  EXPECT_TRUE(b.IsShared());
+  b(3, 4) += 1.0;
+  EXPECT_NE(b.getMatrix()[0], a.getMatrix()[0]);
+  EXPECT_TRUE(b.IsCopyOnWrite());
+  EXPECT_FALSE(b.IsShared());
+  EXPECT_DOUBLE_EQ(b(3, 4), plain(3, 4) + 1.0);
+  EXPECT_TRUE(a == plain);
+  EXPECT_TRUE(c == plain);
+
+  c.MulNumber(2.0);
+  a.Apply([](double x) { return -x; });
+  EXPECT_FALSE(a.IsShared());
+  EXPECT_DOUBLE_EQ(c(1, 1), 2.0 * plain(1, 1));
+  EXPECT_DOUBLE_EQ(a(1, 1), -plain(1, 1));
+
+  S21Matrix small(2, 2);
+  small.EnableCopyOnWrite();
+  EXPECT_FALSE(small.IsCopyOnWrite());
+}
+
+TEST(S21MatrixTest, CopyOnWriteAcrossThreads) {
+  S21Matrix source(100, 100);
+  FillMatrix(source, 29);
+  const S21Matrix expected(source);
+  source.EnableCopyOnWrite();
+  std::vector<double> sums(4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&source, &sums, t]() {
+      S21Matrix local(source);
+      if (t % 2 == 0) local(0, 0) = t;
+      sums[t] = local.Sum();
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  EXPECT_FALSE(source.IsShared());
+  EXPECT_TRUE(source == expected);
+  double base = expected.Sum();
+  EXPECT_DOUBLE_EQ(sums[1], base);
+  EXPECT_NEAR(sums[2], base - expected(0, 0) + 2.0, 1e-9);
+}
+
+// Тестирование кеша результатов
+TEST(S21MatrixTest, ResultCacheHitsOnEqualInput) {
+  S21ResultCache &cache = S21ResultCache::Instance();
+  cache.Clear();
+  cache.SetCapacity(8);
+  S21Matrix a(6, 6);
+  FillMatrix(a, 30);
+  for (int i = 0; i < 6; ++i) a(i, i) += 4.0;
+  S21Matrix inverse = a.InverseMatrix();
+  double det = a.Determinant();
+  S21Matrix complements = a.CalcComplements();
+  S21CacheStats stats = cache.Stats();
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(stats.size, 3u);
+
+  S21Matrix same(a);  // другой объект с теми же данными
+  EXPECT_TRUE(same.InverseMatrix() == inverse);
+  EXPECT_EQ(same.Determinant(), det);
+  EXPECT_TRUE(same.CalcComplements() == complements);
+  EXPECT_EQ(cache.Stats().hits, 3u);
+
+  same(2, 3) += 1.0;
+  EXPECT_NE(same.Determinant(), det);
+  EXPECT_EQ(cache.Stats().misses, 4u);
+  EXPECT_NE(S21ResultCache::Hash(same), S21ResultCache::Hash(a));
+
+  // при совпадении хеша близкая или содержащая NaN матрица не подходит
+  S21Matrix result;
+  S21Matrix close(a);
+  close(0, 0) += 1e-9;
+  cache.Insert(S21CachedOp::kInverse, a, 42, inverse);
+  EXPECT_FALSE(cache.Find(S21CachedOp::kInverse, close, 42, result));
+  S21Matrix with_nan(a);
+  with_nan(1, 1) = NAN;
+  cache.Insert(S21CachedOp::kInverse, with_nan, 43, inverse);
+  EXPECT_FALSE(cache.Find(S21CachedOp::kInverse, a, 43, result));
+  EXPECT_TRUE(cache.Find(S21CachedOp::kInverse, a, 42, result));
+
+  // ошибки не кешируются
+  S21Matrix singular(5, 5);
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  cache.SetCapacity(0);
+  EXPECT_FALSE(cache.Enabled());
+  EXPECT_EQ(cache.Stats().size, 0u);
+  cache.Clear();
+}
+
+TEST(S21MatrixTest, ResultCacheEvictsLeastRecentlyUsed) {
+  S21ResultCache &cache = S21ResultCache::Instance();
+  cache.Clear();
+  cache.SetCapacity(2);
+  std::vector<S21Matrix> inputs;
+  for (int k = 0; k < 3; ++k) {
+    inputs.emplace_back(5, 5);
+    FillMatrix(inputs.back(), 31 + k);
+  }
+  inputs[0].Determinant();
+  inputs[1].Determinant();
+  inputs[0].Determinant();  // теперь самый старый - inputs[1]
+  inputs[2].Determinant();
+  EXPECT_EQ(cache.Stats().evictions, 1u);
+  inputs[0].Determinant();
+  EXPECT_EQ(cache.Stats().hits, 2u);
+  inputs[1].Determinant();
+  EXPECT_EQ(cache.Stats().misses, 4u);
+  cache.SetCapacity(0);
+  cache.Clear();
+}
+
+// Тестирование точной арифметики
+TEST(S21MatrixTest, ExactDeterminantOfIntegerMatrix) {
+  // произведения миноров на последних шагах выходят за 128 бит
+  const int n = 12;
+  S21ExactMatrix a(n, n);
+  unsigned state = 7;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      state = state * 1103515245u + 12345u;
+      a(i, j) = static_cast<long long>(state >> 16) % 201 - 100;
+    }
+  }
+  S21Rational det = a.Determinant();
+  EXPECT_EQ(det.ToString(), "8652046119465702831352726");
+  // перестановка строк меняет знак, удвоение строки удваивает определитель
+  S21ExactMatrix swapped(a), doubled(a);
+  for (int j = 0; j < n; ++j) {
+    std::swap(swapped(0, j), swapped(1, j));
+    doubled(2, j) = doubled(2, j) * S21Rational(2);
+  }
+  EXPECT_TRUE(swapped.Determinant() == -det);
+  EXPECT_TRUE(doubled.Determinant() == det * S21Rational(2));
+
+  S21Matrix small(3, 3);
+  small(0, 0) = 2, small(0, 1) = -3, small(0, 2) = 1;
+  small(1, 0) = 2, small(1, 1) = 0, small(1, 2) = -1;
+  small(2, 0) = 1, small(2, 1) = 4, small(2, 2) = 5;
+  EXPECT_EQ(S21ExactMatrix(small).Determinant().ToString(), "49");
+  S21ExactMatrix singular(3, 3);
+  EXPECT_TRUE(singular.Determinant() == S21Rational());
+}
+
+TEST(S21MatrixTest, ExactInverseOfRationalMatrix) {
+  const int n = 6;
+  S21ExactMatrix hilbert(n, n), identity(n, n);
+  for (int i = 0; i < n; ++i) {
+    identity(i, i) = 1;
+    for (int j = 0; j < n; ++j) hilbert(i, j) = S21Rational(1, i + j + 1);
+  }
+  S21ExactMatrix inverse = hilbert.InverseMatrix();
+  EXPECT_TRUE(hilbert.Multiply(inverse) == identity);
+  EXPECT_TRUE(inverse.Multiply(hilbert) == identity);
+  // у обратной к матрице Гильберта целые элементы, (H^-1)_00 = n^2
+  EXPECT_EQ(inverse(0, 0).ToString(), "36");
+  EXPECT_EQ(inverse(n - 1, n - 1).ToString(), "698544");
+  EXPECT_EQ(hilbert.Determinant().ToString(), "1/186313420339200000");
+
+  S21Matrix a(3, 3);
+  a(0, 0) = 0.5, a(0, 1) = 0.25, a(1, 1) = 1, a(2, 2) = -0.125, a(2, 0) = 3;
+  S21ExactMatrix exact(a);
+  S21Matrix approx = exact.InverseMatrix().ToMatrix();
+  EXPECT_TRUE(approx == a.InverseMatrix());
+  EXPECT_EQ(S21Rational::FromDouble(0.1).getDenominator(),
+            S21Integer(1) << 55);
+
+  S21ExactMatrix singular(2, 2);
+  EXPECT_THROW(singular.InverseMatrix(), std::invalid_argument);
+  EXPECT_THROW(S21ExactMatrix(2, 3).Determinant(), std::invalid_argument);
+  EXPECT_THROW(S21Rational(1, 0), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, ExactArithmeticReportsOverflow) {
+  S21ExactMatrix big(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      big(i, j) = S21Rational(
+          (S21Integer(1) << 100) + i * 7 + j * j * 3 + (i == j), 1);
+    }
+  }
+  // сам определитель помещается в 128 бит
+  EXPECT_EQ(big.Determinant().ToString(), "3802951800684688204490109615913");
+  S21ExactMatrix huge(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) huge(i, j) = i + j;
+    huge(i, i) = S21Rational(S21Integer(1) << 60, 1);
+  }
+  EXPECT_THROW(huge.Determinant(), std::overflow_error);
+  EXPECT_THROW(S21Rational::FromDouble(1e300), std::overflow_error);
+  EXPECT_THROW(S21Rational::FromDouble(NAN), std::invalid_argument);
+}
+
+// Тестирование плиточного хранения
+TEST(S21MatrixTest, TiledRoundTripBothOrders) {
+  S21Matrix a(70, 45);
+  FillMatrix(a, 32);
+  for (S21TileOrder order :
+       {S21TileOrder::kBlockMajor, S21TileOrder::kMorton}) {
+    S21TiledMatrix tiled(a, 16, order);
+    EXPECT_EQ(tiled.getRows(), 70);
+    EXPECT_EQ(tiled.getCols(), 45);
+    EXPECT_EQ(tiled(69, 44), a(69, 44));
+    EXPECT_EQ(tiled(17, 3), a(17, 3));
+    EXPECT_TRUE(tiled.ToMatrix() == a);
+    EXPECT_TRUE(tiled.Transpose().ToMatrix() == a.Transpose());
+    tiled(5, 40) = 7.0;
+    EXPECT_EQ(tiled.ToMatrix()(5, 40), 7.0);
+  }
+  S21TiledMatrix tiled(a, 16);
+  EXPECT_THROW(tiled(70, 0), std::out_of_range);
+  EXPECT_THROW(S21TiledMatrix(2, 2, 0), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, TiledMultiplyMatchesMultiply) {
+  S21Matrix a(130, 75), b(75, 90);
+  FillMatrix(a, 33);
+  FillMatrix(b, 34);
+  S21Matrix expected = a * b;
+  for (S21TileOrder order :
+       {S21TileOrder::kBlockMajor, S21TileOrder::kMorton}) {
+    S21TiledMatrix product =
+        S21TiledMatrix(a, 32, order).Multiply(S21TiledMatrix(b, 32, order));
+    EXPECT_TRUE(product.ToMatrix() == expected);
+  }
+  EXPECT_THROW(S21TiledMatrix(a, 32).Multiply(S21TiledMatrix(b, 16)),
+               std::invalid_argument);
+  EXPECT_THROW(S21TiledMatrix(a, 32).Multiply(S21TiledMatrix(a, 32)),
+               std::invalid_argument);
+
+  // Inf в краевой плитке не оставляет NaN в дополнении, которое
+  // следующее умножение перенесло бы в результат
+  S21Matrix inf(3, 3), ones(3, 3);
+  inf(2, 2) = INFINITY;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) ones(i, j) = 1.0;
+  }
+  S21TiledMatrix tiled_ones(ones, 2);
+  S21Matrix chained = S21TiledMatrix(inf, 2)
+                          .Multiply(tiled_ones)
+                          .Multiply(tiled_ones)
+                          .ToMatrix();
+  S21Matrix dense_chained = inf * ones * ones;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_EQ(chained(i, j), dense_chained(i, j));
+    }
+  }
+  EXPECT_EQ(chained(2, 0), INFINITY);
+
+  // нулевой элемент A на бесконечность в B даёт NaN
+  S21Matrix zero(2, 2), special(2, 2);
+  special(0, 0) = INFINITY;
+  special(1, 1) = NAN;
+  S21Matrix tiled =
+      S21TiledMatrix(zero, 2).Multiply(S21TiledMatrix(special, 2)).ToMatrix();
+  S21Matrix dense = zero * special;
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      EXPECT_TRUE(std::isnan(tiled(i, j)));
+      EXPECT_TRUE(std::isnan(dense(i, j)));
+    }
+  }
+}
+
+// Тестирование обновлений обратной матрицы малого ранга
+TEST(S21MatrixTest, UpdatableInverseTracksRankOneChanges) {
+  const int n = 40;
+  S21Matrix a(n, n);
+  FillMatrix(a, 35);
+  for (int i = 0; i < n; ++i) a(i, i) += 20.0;
+  S21UpdatableInverse tracker(a, 0);
+  S21Matrix row(1, n);
+  for (int step = 0; step < 10; ++step) {
+    tracker.SetElement(step, (step * 7) % n, 3.0 + step);
+    for (int j = 0; j < n; ++j) row(0, j) = ((j + step) % 5) - 2.0;
+    row(0, step + 10) += 25.0;
+    tracker.SetRow(step + 10, row);
+  }
+  EXPECT_EQ(tracker.getUpdatesSinceRefactor(), 20);
+  EXPECT_EQ(tracker.getMatrix()(3, 21), 3.0 + 3);
+  S21Matrix expected = tracker.getMatrix().InverseMatrix();
+  EXPECT_LT((tracker.getInverse() - expected).MaxAbs(), 1e-12);
+  S21UpdatableInverse fresh(tracker.getMatrix());
+  EXPECT_NEAR(tracker.getDeterminant(), fresh.getDeterminant(),
+              1e-10 * std::fabs(fresh.getDeterminant()));
+}
+
+TEST(S21MatrixTest, UpdatableInverseRankKAndRefactor) {
+  const int n = 6;
+  S21Matrix a(n, n), u(n, 3), v(n, 3);
+  FillMatrix(a, 36);
+  FillMatrix(u, 37);
+  FillMatrix(v, 38);
+  for (int i = 0; i < n; ++i) a(i, i) += 10.0;
+  S21UpdatableInverse tracker(a, 2);
+  EXPECT_NEAR(tracker.getDeterminant(), a.Determinant(),
+              1e-10 * std::fabs(a.Determinant()));
+  tracker.Update(u, v);
+  S21Matrix updated = a + u * v.Transpose();
+  EXPECT_TRUE(tracker.getMatrix() == updated);
+  EXPECT_TRUE(tracker.getInverse() == updated.InverseMatrix());
+  EXPECT_NEAR(tracker.getDeterminant(), updated.Determinant(),
+              1e-10 * std::fabs(updated.Determinant()));
+  EXPECT_EQ(tracker.getUpdatesSinceRefactor(), 1);
+  tracker.SetElement(0, 0, 1.0);
+  EXPECT_EQ(tracker.getUpdatesSinceRefactor(), 0);
+
+  // строка 1 совпадает со строкой 0 - матрица вырождена, состояние прежнее
+  S21Matrix before = tracker.getInverse();
+  S21Matrix row(1, n);
+  for (int j = 0; j < n; ++j) row(0, j) = tracker.getMatrix()(0, j);
+  EXPECT_THROW(tracker.SetRow(1, row), std::invalid_argument);
+  EXPECT_TRUE(tracker.getInverse() == before);
+  EXPECT_THROW(tracker.Update(u, S21Matrix(n, 2)), std::invalid_argument);
+  EXPECT_THROW(S21UpdatableInverse(S21Matrix(3, 3)), std::invalid_argument);
+
+  // обновление проходит проверку ёмкостной матрицы, но новая матрица
+  // переполняется и переразложение отвергает её
+  S21Matrix big(2, 2);
+  big(0, 0) = big(1, 1) = 1e300;
+  S21UpdatableInverse overflow(big, 1);
+  S21Matrix inverse = overflow.getInverse();
+  S21Matrix e(2, 1);
+  e(0, 0) = 1e300;
+  EXPECT_THROW(overflow.Update(e, e), std::invalid_argument);
+  EXPECT_TRUE(overflow.getMatrix() == big);
+  EXPECT_EQ(overflow.getInverse()(0, 0), inverse(0, 0));
+  EXPECT_EQ(overflow.getUpdatesSinceRefactor(), 0);
+}
+
+TEST(S21MatrixTest, StatusVariantsMatchThrowingOperations) {
+  static_assert(noexcept(S21TrySum(std::declval<const S21Matrix &>(),
+                                   std::declval<const S21Matrix &>(),
+                                   std::declval<S21Matrix &>())),
+                "status variants must not throw");
+  S21Matrix a(5, 7), b(5, 7), c(7, 3);
+  FillMatrix(a, 1);
+  FillMatrix(b, 2);
+  FillMatrix(c, 3);
+  S21Matrix out(5, 7), product(5, 3);
+  EXPECT_EQ(S21TrySum(a, b, out), S21Status::kOk);
+  EXPECT_TRUE(out == a + b);
+  EXPECT_EQ(S21TrySub(a, b, out), S21Status::kOk);
+  EXPECT_TRUE(out == a - b);
+  S21Matrix scaled(a);
+  EXPECT_EQ(S21TryMulNumber(scaled, -1.5, scaled), S21Status::kOk);
+  S21Matrix expected(a);
+  expected.MulNumber(-1.5);
+  EXPECT_TRUE(scaled == expected);
+  EXPECT_EQ(S21TryMultiply(a, c, product), S21Status::kOk);
+  EXPECT_TRUE(product == a * c);
+
+  EXPECT_EQ(S21TrySum(a, c, out), S21Status::kDimensionMismatch);
+  EXPECT_EQ(S21TryMultiply(a, b, product), S21Status::kDimensionMismatch);
+  S21Matrix moved(5, 7);
+  S21Matrix target(std::move(moved));
+  EXPECT_EQ(S21TrySum(a, moved, out), S21Status::kEmptyMatrix);
+  EXPECT_EQ(S21TryMultiply(a, c, out), S21Status::kInvalidOutput);
+  S21Matrix square(4, 4);
+  FillMatrix(square, 4);
+  EXPECT_EQ(S21TryMultiply(square, square, square), S21Status::kInvalidOutput);
+
+  // результат не пишется в хранилище, разделённое с другой матрицей
+  S21Matrix shared(6, 6);
+  shared.EnableCopyOnWrite();
+  S21Matrix copy(shared);
+  EXPECT_EQ(S21TrySum(shared, shared, copy), S21Status::kInvalidOutput);
+  EXPECT_STREQ(S21StatusMessage(S21Status::kNotSquare),
+               "Matrix must be square.");
+}
+
+TEST(S21MatrixTest, StatusDeterminantAndInverse) {
+  S21Matrix a(6, 6);
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 6; ++j) a(i, j) = 1.0 / (i + j + 1) + (i == j);
+  }
+  S21Matrix work(6, 6), inverse(6, 6);
+  double det = 0.0;
+  EXPECT_EQ(S21TryDeterminant(a, work, det), S21Status::kOk);
+  EXPECT_NEAR(det, a.Determinant(), 1e-12 * std::fabs(det));
+  EXPECT_EQ(S21TryInverse(a, work, inverse), S21Status::kOk);
+  EXPECT_TRUE(inverse == a.InverseMatrix());
+
+  S21Matrix singular(3, 3);
+  FillMatrix(singular, 5);
+  singular(2, 0) = singular(0, 0) + singular(1, 0);
+  singular(2, 1) = singular(0, 1) + singular(1, 1);
+  singular(2, 2) = singular(0, 2) + singular(1, 2);
+  S21Matrix work3(3, 3), out3(3, 3);
+  EXPECT_EQ(S21TryInverse(S21Matrix(3, 3), work3, out3), S21Status::kSingular);
+  EXPECT_EQ(S21TryDeterminant(S21Matrix(3, 3), work3, det), S21Status::kOk);
+  EXPECT_EQ(det, 0.0);
+  EXPECT_EQ(S21TryDeterminant(S21Matrix(3, 4), work3, det),
+            S21Status::kNotSquare);
+  EXPECT_EQ(S21TryDeterminant(a, work3, det), S21Status::kInvalidOutput);
+  EXPECT_EQ(S21TryInverse(a, work, work), S21Status::kInvalidOutput);
+}
+
+TEST(S21MatrixTest, ViewWorksInForeignMemory) {
+  std::vector<double> buffer(12, 0.0);
+  S21Matrix view = S21Matrix::View(buffer.data(), 3, 4);
+  EXPECT_TRUE(view.IsView());
+  view(2, 1) = 5.0;
+  EXPECT_EQ(buffer[9], 5.0);
+  buffer[3] = -2.0;
+  EXPECT_EQ(view(0, 3), -2.0);
+
+  // копия и результат операций владеют своей памятью
+  S21Matrix copy(view);
+  EXPECT_FALSE(copy.IsView());
+  copy(0, 0) = 1.0;
+  EXPECT_EQ(buffer[0], 0.0);
+  S21Matrix moved(std::move(view));
+  EXPECT_TRUE(moved.IsView());
+  moved.EnableCopyOnWrite();
+  EXPECT_FALSE(moved.IsCopyOnWrite());
+  moved = moved * moved.Transpose();
+  EXPECT_FALSE(moved.IsView());
+  EXPECT_EQ(buffer[9], 5.0);
+
+  // маленькое представление не переносится во встроенный буфер
+  double small[2] = {1.0, 2.0};
+  S21Matrix row = S21Matrix::View(small, 1, 2);
+  S21Matrix taken(std::move(row));
+  taken(0, 1) = 3.0;
+  EXPECT_EQ(small[1], 3.0);
+  EXPECT_THROW(S21Matrix::View(nullptr, 2, 2), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::View(small, 0, 2), std::invalid_argument);
+}
+
+// Счётчик выделений через глобальный operator new: хранилище кучи
+// матрицы всегда выделяет массив строк через new[]
+static std::atomic<long> heap_allocations{0};
+
+void *operator new(std::size_t size) {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  const std::size_t align = static_cast<std::size_t>(alignment);
+  const std::size_t padded = (std::max<std::size_t>(size, 1) + align - 1) /
+                             align * align;
+  if (void *pointer = std::aligned_alloc(align, padded)) return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+// Тестирование операций с результатом в переданной матрице
+TEST(S21MatrixTest, IntoVariantsReuseOutputStorage) {
+  S21Matrix a(40, 40);
+  S21Matrix b(40, 40);
+  FillMatrix(a, 1);
+  FillMatrix(b, 2);
+  for (int i = 0; i < 40; ++i) a(i, i) += 60.0;
+  S21Matrix small(5, 5);
+  FillMatrix(small, 3);
+  S21Matrix sum(40, 40), difference(40, 40), product(40, 40);
+  S21Matrix transposed(40, 40), minor(39, 39), inverse(40, 40);
+  S21Matrix complements(5, 5);
+  double *const product_data = product.getMatrix()[0];
+  double *const inverse_data = inverse.getMatrix()[0];
+  auto step = [&]() {
+    a.SumInto(b, sum);
+    a.SubInto(b, difference);
+    a.MultiplyInto(b, product);
+    a.TransposeInto(transposed);
+    a.GetMinorInto(3, 5, minor);
+    a.InverseMatrixInto(inverse);
+    small.CalcComplementsInto(complements);
+  };
+  // первый проход заводит буферы потока
+  step();
+  const long before = heap_allocations.load();
+  for (int iter = 0; iter < 3; ++iter) step();
+  EXPECT_EQ(heap_allocations.load() - before, 0);
+  EXPECT_EQ(product.getMatrix()[0], product_data);
+  EXPECT_EQ(inverse.getMatrix()[0], inverse_data);
+
+  EXPECT_TRUE(sum == a + b);
+  EXPECT_TRUE(difference == a - b);
+  EXPECT_TRUE(product == a * b);
+  EXPECT_TRUE(transposed == a.Transpose());
+  EXPECT_TRUE(minor == a.GetMinor(3, 5));
+  EXPECT_TRUE(inverse == a.InverseMatrix());
+  EXPECT_TRUE(complements == small.CalcComplements());
+}
+
+TEST(S21MatrixTest, IntoVariantsHandleAliasingAndShape) {
+  S21Matrix a(3, 3);
+  FillMatrix(a, 4);
+  for (int i = 0; i < 3; ++i) a(i, i) += 10.0;
+  S21Matrix square = a * a;
+  S21Matrix aliased = a;
+  aliased.MultiplyInto(aliased, aliased);
+  EXPECT_TRUE(aliased == square);
+  S21Matrix transposed = a;
+  transposed.TransposeInto(transposed);
+  EXPECT_TRUE(transposed == a.Transpose());
+  S21Matrix inverse = a;
+  inverse.InverseMatrixInto(inverse);
+  EXPECT_TRUE(inverse == a.InverseMatrix());
+
+  // неподходящий размер: хранилище выделяется заново
+  S21Matrix out(7, 2);
+  a.GetMinorInto(1, 1, out);
+  EXPECT_TRUE(out == a.GetMinor(1, 1));
+  S21Matrix wide(3, 5);
+  FillMatrix(wide, 5);
+  a.MultiplyInto(wide, out);
+  EXPECT_TRUE(out == a * wide);
+
+  // разделённое хранилище отделяется, источник не меняется
+  S21Matrix big(6, 6);
+  FillMatrix(big, 6);
+  S21Matrix original = big;
+  big.EnableCopyOnWrite();
+  S21Matrix shared = big;
+  S21Matrix expected = big + big;
+  big.SumInto(big, shared);
+  EXPECT_TRUE(shared == expected);
+  EXPECT_TRUE(big == original);
+  EXPECT_FALSE(big.IsShared());
+
+  // представления над одним буфером со сдвигом на строку
+  double buffer[12];
+  for (int i = 0; i < 12; ++i) buffer[i] = i;
+  S21Matrix top = S21Matrix::View(buffer, 3, 3);
+  S21Matrix bottom = S21Matrix::View(buffer + 3, 3, 3);
+  S21Matrix shifted = top + bottom;
+  top.SumInto(bottom, bottom);
+  EXPECT_TRUE(bottom == shifted);
+  EXPECT_TRUE(bottom.IsView());
+  EXPECT_EQ(buffer[11], 8.0 + 11.0);
+
+  // при ошибке проверки out не меняется
+  S21Matrix kept = a;
+  EXPECT_THROW(a.SumInto(wide, kept), std::invalid_argument);
+  EXPECT_THROW(wide.InverseMatrixInto(kept), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(3, 3).InverseMatrixInto(kept), std::invalid_argument);
+  EXPECT_THROW(a.GetMinorInto(3, 0, kept), std::out_of_range);
+  EXPECT_TRUE(kept == a);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
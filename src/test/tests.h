@@ -3,6 +3,24 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#include "../s21_exact_matrix.h"
+#include "../s21_executor.h"
+#include "../s21_inverse_update.h"
 #include "../s21_matrix_oop.h"
+#include "../s21_matrix_status.h"
+#include "../s21_numa.h"
+#include "../s21_parallel.h"
+#include "../s21_result_cache.h"
+#include "../s21_structured_matrix.h"
+#include "../s21_tiled_matrix.h"
 
 #endif
\ No newline at end of file